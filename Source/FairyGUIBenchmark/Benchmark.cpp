@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+#include "FairyGUI.h"
+#include "utils/SlabAllocator.h"
+
+#include <sstream>
+#include <crtdbg.h>
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
+
+std::vector<Benchmark::Result> Benchmark::_results;
+
+#ifdef _DEBUG
+static long long s_allocCount = 0;
+
+static int allocHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+    if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+        s_allocCount++;
+    return TRUE;
+}
+#endif
+
+void Benchmark::run(const std::string & name, int iterations, const std::function<void(int)>& body)
+{
+    //one untimed pass so lazy initialisation is not charged to the first op
+    body(0);
+
+#ifdef _DEBUG
+    s_allocCount = 0;
+    _CRT_ALLOC_HOOK oldHook = _CrtSetAllocHook(allocHook);
+#endif
+    int poolAllocs = fairygui::SlabAllocator::getAllocationCount();
+
+    long long start = now();
+    for (int i = 0; i < iterations; i++)
+        body(i);
+    long long elapsed = now() - start;
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = toNanoseconds(elapsed) / iterations;
+#ifdef _DEBUG
+    _CrtSetAllocHook(oldHook);
+    result.allocsPerOp = (double)s_allocCount / iterations;
+#else
+    result.allocsPerOp = -1;
+#endif
+    result.poolAllocsPerOp = (double)(fairygui::SlabAllocator::getAllocationCount() - poolAllocs) / iterations;
+    result.peakRss = getPeakRss();
+    _results.push_back(result);
+
+    hkvLog::Info("%s: %.1f ns/op, %.2f allocs/op, %.2f pool allocs/op, peak rss %u KB", name.c_str(),
+        result.nsPerOp, result.allocsPerOp, result.poolAllocsPerOp, (unsigned int)(result.peakRss / 1024));
+}
+
+void Benchmark::skip(const std::string & name, const char * reason)
+{
+    hkvLog::Warning("%s: skipped, %s", name.c_str(), reason);
+}
+
+std::string Benchmark::toJson()
+{
+    std::ostringstream ss;
+    ss.setf(std::ios::fixed);
+    ss.precision(2);
+
+    ss << "{\"benchmarks\":[";
+    for (size_t i = 0; i < _results.size(); i++)
+    {
+        const Result& r = _results[i];
+        if (i != 0)
+            ss << ",";
+        ss << "{\"name\":\"" << r.name << "\",\"iterations\":" << r.iterations
+            << ",\"nsPerOp\":" << r.nsPerOp
+            << ",\"allocsPerOp\":" << r.allocsPerOp
+            << ",\"poolAllocsPerOp\":" << r.poolAllocsPerOp
+            << ",\"peakRssBytes\":" << r.peakRss << "}";
+    }
+    ss << "]}";
+
+    return ss.str();
+}
+
+long long Benchmark::now()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+double Benchmark::toNanoseconds(long long ticks)
+{
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    return ticks * 1000000000.0 / frequency.QuadPart;
+}
+
+size_t Benchmark::getPeakRss()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    else
+        return 0;
+}
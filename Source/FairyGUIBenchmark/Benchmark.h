@@ -0,0 +1,39 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <Vision/Runtime/Engine/System/Vision.hpp>
+
+#include <string>
+#include <vector>
+#include <functional>
+
+//Runs a scenario body a number of times and records ns/op, allocations/op,
+//slab pool allocations/op and the peak working set. Results are written as one JSON document.
+class Benchmark
+{
+public:
+    struct Result
+    {
+        std::string name;
+        int iterations;
+        double nsPerOp;
+        double allocsPerOp; //-1 when the CRT allocation hook is not available
+        double poolAllocsPerOp; //blocks served by SlabAllocator instead of the heap
+        size_t peakRss;
+    };
+
+    static void run(const std::string& name, int iterations, const std::function<void(int)>& body);
+    static void skip(const std::string& name, const char* reason);
+
+    static const std::vector<Result>& getResults() { return _results; }
+    static std::string toJson();
+
+private:
+    static long long now();
+    static double toNanoseconds(long long ticks);
+    static size_t getPeakRss();
+
+    static std::vector<Result> _results;
+};
+
+#endif
@@ -0,0 +1,96 @@
+//  Headless benchmark host for the FairyGUI plugin.
+//
+//  FairyGUIBenchmark.exe [--package UI/Basics] [--component Main] [--list ListDemo]
+//                        [--transition t0] [--scale 1] [--out results.json]
+//
+//  The engine runs in a small window with an empty world, so a frame is mostly FairyGUI work.
+//  Results go to stdout and, with --out, to a JSON file for regression gating.
+
+#include "Benchmark.h"
+#include "Scenarios.h"
+#include "FairyGUI.h"
+#include "FGUIManager.h"
+
+#include <Vision/Runtime/Framework/VisionApp/VisionApp.hpp>
+
+VIMPORT IVisPlugin_cl* GetEnginePlugin_FairyGUIEnginePlugin();
+
+static bool parseArgs(int argc, char** argv, BenchmarkOptions& options, std::string& outFile)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--package")
+            options.packagePath = value;
+        else if (arg == "--component")
+            options.component = value;
+        else if (arg == "--list")
+            options.listComponent = value;
+        else if (arg == "--transition")
+            options.transition = value;
+        else if (arg == "--scale")
+            options.scale = atoi(value) > 0 ? atoi(value) : 1;
+        else if (arg == "--out")
+            outFile = value;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    std::string outFile;
+    if (!parseArgs(argc, argv, options, outFile))
+        return 1;
+
+    VisionAppHelpers::MakeEXEDirCurrent();
+
+    VisionAppPtr spApp = new VisionApp_cl();
+    VisAppConfig_cl config(320, 240, false);
+    config.m_videoConfig.m_bWaitVRetrace = false;
+    if (!spApp->InitEngine(&config))
+    {
+        fprintf(stderr, "cannot initialize the engine\n");
+        return 1;
+    }
+    Vision::InitWorld();
+
+    Vision::File.AddDataDirectory(".");
+    GetEnginePlugin_FairyGUIEnginePlugin()->InitEnginePlugin();
+
+    options.stepFrame = [&spApp]() { spApp->Run(); };
+    runScenarios(options);
+
+    std::string json = Benchmark::toJson();
+    printf("%s\n", json.c_str());
+    if (!outFile.empty())
+    {
+        FILE* fp = fopen(outFile.c_str(), "wb");
+        if (fp)
+        {
+            fwrite(json.c_str(), 1, json.size(), fp);
+            fclose(fp);
+        }
+        else
+            fprintf(stderr, "cannot write %s\n", outFile.c_str());
+    }
+
+    GetEnginePlugin_FairyGUIEnginePlugin()->DeInitEnginePlugin();
+    Vision::DeInitWorld();
+    spApp->DeInitEngine();
+    spApp = NULL;
+
+    return 0;
+}
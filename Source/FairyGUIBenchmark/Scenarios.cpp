@@ -0,0 +1,382 @@
+#include "Scenarios.h"
+#include "Benchmark.h"
+#include "FairyGUI.h"
+#include "third_party/cc/CCAutoreleasePool.h"
+#include "core/BitmapFont.h"
+#include "core/TextField.h"
+#include "core/Image.h"
+#include "core/NGraphics.h"
+
+USING_NS_FGUI;
+
+static const int BENCH_EVENT = 10000;
+
+static GList* findList(GComponent* com)
+{
+    for (auto &it : com->getChildren())
+    {
+        GList* list = dynamic_cast<GList*>(it);
+        if (list != nullptr && list->getScrollPane() != nullptr)
+            return list;
+    }
+    return nullptr;
+}
+
+static void benchLoadPackage(const BenchmarkOptions& options)
+{
+    if (options.packagePath.empty())
+    {
+        Benchmark::skip("loadPackage", "no --package given");
+        return;
+    }
+
+    Benchmark::run("loadPackage", 20 * options.scale, [&](int)
+    {
+        UIPackage* pkg = UIPackage::addPackage(options.packagePath);
+        UIPackage::removePackage(pkg->getId());
+    });
+}
+
+static void benchCreateObject(const BenchmarkOptions& options, const std::string& pkgName)
+{
+    if (options.component.empty())
+    {
+        Benchmark::skip("createObject", "no --component given");
+        return;
+    }
+
+    int n = 1000 * options.scale;
+    Benchmark::run("createObject", n, [&](int)
+    {
+        UIPackage::createObject(pkgName, options.component);
+    });
+    options.stepFrame(); //drains the autorelease pool
+}
+
+//Creates a component and disposes it in the same op, which is the churn of opening and closing
+//a screen. Build with FGUI_ENABLE_SLAB_POOLS=0 to get the heap-only numbers for comparison.
+static void benchCreateDisposeComponent(const BenchmarkOptions& options, const std::string& pkgName)
+{
+    if (options.component.empty())
+    {
+        Benchmark::skip("createDisposeComponent", "no --component given");
+        return;
+    }
+
+    Benchmark::run("createDisposeComponent", 1000 * options.scale, [&](int)
+    {
+        UIPackage::createObject(pkgName, options.component);
+        PoolManager::getInstance()->getCurrentPool()->clear();
+    });
+
+    //the same with an arena per component, the pool allocations are then cut from its slabs
+    bool componentArenas = UIConfig::componentArenas;
+    UIConfig::componentArenas = true;
+    Benchmark::run("createDisposeComponentArena", 1000 * options.scale, [&](int)
+    {
+        UIPackage::createObject(pkgName, options.component);
+        PoolManager::getInstance()->getCurrentPool()->clear();
+    });
+    UIConfig::componentArenas = componentArenas;
+}
+
+//Only a component with a scroll pane (or a list) keeps the bounds of its children in a tree,
+//setupScroll is protected so the scenario makes its own.
+class ScrollingComponent : public GComponent
+{
+public:
+    CREATE_FUNC(ScrollingComponent);
+
+protected:
+    virtual void handleInit() override
+    {
+        GComponent::handleInit();
+        setupScroll(Margin(), ScrollType::BOTH, ScrollBarDisplayType::HIDDEN, 0,
+            STD_STRING_EMPTY, STD_STRING_EMPTY, STD_STRING_EMPTY, STD_STRING_EMPTY);
+    }
+};
+
+static void benchMoveChild(const BenchmarkOptions& options)
+{
+    const int childCount = 10000;
+
+    GComponent* com = ScrollingComponent::create();
+    com->retain();
+    com->setSize(400, 400);
+    for (int i = 0; i < childCount; i++)
+    {
+        GGraph* child = GGraph::create();
+        child->setSize(10, 10);
+        child->setPosition((float)(i % 100) * 10, (float)(i / 100) * 10);
+        com->addChild(child);
+    }
+    com->ensureBoundsCorrect();
+
+    Benchmark::run("moveChildIn10k", 10000 * options.scale, [&](int i)
+    {
+        GObject* child = com->getChildAt(i % childCount);
+        child->setPosition(child->getX() + ((i & 1) ? 1.0f : -1.0f), child->getY());
+        com->ensureBoundsCorrect();
+    });
+
+    com->release();
+}
+
+static void benchVirtualListScroll(const BenchmarkOptions& options, const std::string& pkgName)
+{
+    GObject* obj = options.listComponent.empty() ? nullptr : UIPackage::createObject(pkgName, options.listComponent);
+    GComponent* com = obj ? obj->as<GComponent>() : nullptr;
+    GList* list = com ? findList(com) : nullptr;
+    if (list == nullptr)
+    {
+        Benchmark::skip("virtualListScroll", "no --list component with a scrollable list");
+        return;
+    }
+
+    com->retain();
+    UIRoot->addChild(com);
+    list->itemRenderer = [](int index, GObject* obj) { obj->setText("item"); };
+    list->setVirtual();
+    list->setNumItems(100000);
+
+    ScrollPane* scrollPane = list->getScrollPane();
+    Benchmark::run("virtualListScroll", 2000 * options.scale, [&](int i)
+    {
+        scrollPane->setPercY((float)(i % 1000) / 1000);
+        options.stepFrame();
+    });
+
+    UIRoot->removeChild(com);
+    com->release();
+}
+
+static void benchTextLayout(const BenchmarkOptions& options)
+{
+    const int count = 10000;
+
+    std::vector<GTextField*> fields;
+    fields.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        GTextField* tf = GTextField::create();
+        tf->retain();
+        tf->setAutoSize(TextAutoSize::BOTH);
+        fields.push_back(tf);
+    }
+
+    char buf[64];
+    Benchmark::run("textLayout10k", options.scale, [&](int iteration)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            sprintf(buf, "The quick brown fox %d jumps over the lazy dog %d", i, iteration);
+            fields[i]->setText(buf);
+            fields[i]->getTextSize();
+        }
+    });
+
+    for (auto &it : fields)
+        it->release();
+}
+
+//Measures and meshes one million glyphs per op with a synthetic bitmap font: HUD style
+//counters, with a CJK line every 16 strings to go through the paged part of the glyph table.
+static void benchBitmapFontGlyphs(const BenchmarkOptions& options)
+{
+    const int glyphCount = 1000000;
+
+    BitmapFont* font = new BitmapFont("benchmark");
+    BitmapFont::BMGlyph glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.width = 16;
+    glyph.height = 24;
+    glyph.advance = 16;
+    glyph.lineHeight = 24;
+    glyph.uv.Set(0, 0, 0.0625f, 0.0625f);
+    for (hkUint32 c = 33; c < 127; c++)
+        font->addGlyph(c, glyph);
+    for (hkUint32 c = 0x4E00; c < 0x4E00 + 1024; c++)
+        font->addGlyph(c, glyph);
+    font->addKerning('1', '1', -2);
+    font->size = 24;
+    font->lineHeight = 24;
+
+    std::vector<std::string> texts;
+    char buf[64];
+    for (int i = 0; i < 1024; i++)
+    {
+        if (i % 16 == 15)
+            texts.push_back("\xE4\xB8\x80\xE4\xB8\x81\xE4\xB8\x82\xE4\xB8\x83\xE4\xB8\x84"
+                "\xE4\xB8\x85\xE4\xB8\x86\xE4\xB8\x87\xE4\xB8\x88\xE4\xB8\x89");
+        else
+        {
+            sprintf(buf, "%010d", i * 7919);
+            texts.push_back(buf);
+        }
+    }
+
+    TextFormat format;
+    format.size = 24;
+    TextRenderElement re;
+    re.format = &format;
+    NGraphics graphics;
+    VRectanglef rect;
+
+    //every text is 10 glyphs
+    Benchmark::run("bitmapFontGlyphs1M", options.scale, [&](int)
+    {
+        for (int i = 0; i < glyphCount / 10; i++)
+        {
+            re.text = texts[i & 1023];
+            font->getTextDimension(re.text.c_str(), format, rect);
+            graphics.clearMesh();
+            font->prepareGraphics(graphics, re);
+        }
+    });
+
+    delete font;
+}
+
+class TiledImage : public Image
+{
+public:
+    CREATE_FUNC(TiledImage);
+    using Image::rebuild;
+};
+
+//Fills a 4096x4096 image with 32x32 tiles of an atlas sprite and of a whole texture. Prints
+//the vertices a quad per tile would take next to what the image builds: capped strips for the
+//sprite, one repeating quad for the texture.
+static void benchTiledImage(const BenchmarkOptions& options)
+{
+    VTextureObject* native = Vision::TextureManager.Create2DTextureObject("benchmark_tiles", 256, 256, 1, VTextureLoader::R8G8B8A8);
+    VTextureObject* whole = Vision::TextureManager.Create2DTextureObject("benchmark_tile", 32, 32, 1, VTextureLoader::R8G8B8A8);
+    if (native == nullptr || whole == nullptr)
+    {
+        Benchmark::skip("tiledImage", "cannot create the textures");
+        return;
+    }
+
+    NTexture* atlas = new NTexture(native);
+    NTexture* sprite = new NTexture(atlas, VRectanglef(0, 0, 32, 32));
+    NTexture* texture = new NTexture(whole);
+    const float size = 4096;
+
+    struct Case
+    {
+        const char* name;
+        NTexture* texture;
+    };
+    Case cases[] = { { "tiledImageSprite", sprite }, { "tiledImageTexture", texture } };
+    for (auto &it : cases)
+    {
+        TiledImage* image = TiledImage::create();
+        image->retain();
+        image->setTexture(it.texture);
+        image->setScaleByTile(true);
+        image->setSize(size, size);
+
+        Benchmark::run(it.name, 100 * options.scale, [&](int)
+        {
+            image->rebuild();
+        });
+
+        int perTile = (int)hkvMath::ceil(size / it.texture->getWidth()) * (int)hkvMath::ceil(size / it.texture->getHeight()) * 6;
+        fprintf(stderr, "%s: %d vertices with a quad per tile, %d built\n", it.name, perTile, image->getGraphics()->getVertexCount());
+        image->release();
+    }
+
+    sprite->release();
+    texture->release();
+    atlas->release();
+}
+
+static void benchTransitions(const BenchmarkOptions& options, const std::string& pkgName)
+{
+    if (options.component.empty() || options.transition.empty())
+    {
+        Benchmark::skip("transitions1k", "no --component/--transition given");
+        return;
+    }
+
+    const int count = 1000;
+
+    std::vector<GComponent*> coms;
+    for (int i = 0; i < count; i++)
+    {
+        GObject* obj = UIPackage::createObject(pkgName, options.component);
+        GComponent* com = obj ? obj->as<GComponent>() : nullptr;
+        if (com == nullptr || com->getTransition(options.transition) == nullptr)
+        {
+            for (auto &it : coms)
+            {
+                UIRoot->removeChild(it);
+                it->release();
+            }
+            Benchmark::skip("transitions1k", "transition not found in component");
+            return;
+        }
+        com->retain();
+        UIRoot->addChild(com);
+        coms.push_back(com);
+    }
+
+    Benchmark::run("transitions1k", 300 * options.scale, [&](int)
+    {
+        for (auto &it : coms)
+        {
+            Transition* trans = it->getTransition(options.transition);
+            if (!trans->isPlaying())
+                trans->play();
+        }
+        options.stepFrame();
+    });
+
+    for (auto &it : coms)
+    {
+        it->getTransition(options.transition)->stop();
+        UIRoot->removeChild(it);
+        it->release();
+    }
+}
+
+static void benchDispatchEvents(const BenchmarkOptions& options)
+{
+    GGraph* target = GGraph::create();
+    target->retain();
+
+    int received = 0;
+    target->addListener(BENCH_EVENT, [&received](EventContext*) { received++; });
+
+    Benchmark::run("dispatchEvent", 1000000 * options.scale, [&](int)
+    {
+        target->dispatchEvent(BENCH_EVENT);
+    });
+
+    target->release();
+}
+
+void runScenarios(const BenchmarkOptions& options)
+{
+    std::string pkgName;
+    if (!options.packagePath.empty())
+    {
+        benchLoadPackage(options);
+
+        UIPackage* pkg = UIPackage::addPackage(options.packagePath);
+        pkgName = pkg->getName();
+    }
+
+    benchCreateObject(options, pkgName);
+    benchCreateDisposeComponent(options, pkgName);
+    benchMoveChild(options);
+    benchVirtualListScroll(options, pkgName);
+    benchTextLayout(options);
+    benchBitmapFontGlyphs(options);
+    benchTiledImage(options);
+    benchTransitions(options, pkgName);
+    benchDispatchEvents(options);
+
+    if (!pkgName.empty())
+        UIPackage::removePackage(pkgName);
+}
@@ -0,0 +1,22 @@
+#ifndef __SCENARIOS_H__
+#define __SCENARIOS_H__
+
+#include <string>
+#include <functional>
+
+struct BenchmarkOptions
+{
+    std::string packagePath;    //asset path passed to UIPackage::addPackage, e.g. "UI/Basics"
+    std::string component;      //component created by the createObject and transition scenarios
+    std::string listComponent;  //component holding a scrollable GList with a default item
+    std::string transition;     //transition name inside 'component'
+    int scale;                  //multiplies every iteration count, 1 is the nominal size
+
+    std::function<void()> stepFrame;
+
+    BenchmarkOptions() : scale(1) {}
+};
+
+void runScenarios(const BenchmarkOptions& options);
+
+#endif
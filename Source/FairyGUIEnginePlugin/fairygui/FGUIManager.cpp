@@ -5,6 +5,12 @@
 #include "core/BaseFont.h"
 #include "core/BitmapFont.h"
 #include "core/NativeFont.h"
+#include "core/TextureResidencyManager.h"
+#include "core/TextureCache.h"
+#include "utils/WorkerPool.h"
+#include "core/TextMeasurer.h"
+#include "core/MovieClipAnimator.h"
+#include "utils/Profiler.h"
 #include "third_party/cc/CCAutoreleasePool.h"
 
 #include <Vision/Runtime/EnginePlugins/VisionEnginePlugin/Scripting/VScriptManager.hpp>
@@ -17,6 +23,11 @@ FGUIManager FGUIManager::g_GlobalManager;
 
 FGUIManager::FGUIManager() :
     _whiteTexture(nullptr),
+    _textureResidencyManager(nullptr),
+    _textureCache(nullptr),
+    _workerPool(nullptr),
+    _textMeasurer(nullptr),
+    _movieClipAnimator(nullptr),
     _scheduler(nullptr),
     _actionManager(nullptr),
     _stage(nullptr),
@@ -30,6 +41,11 @@ FGUIManager::FGUIManager() :
 void FGUIManager::OneTimeInit()
 {
     _whiteTexture = new NTexture();
+    _textureResidencyManager = new TextureResidencyManager();
+    _textureCache = new TextureCache();
+    _workerPool = new WorkerPool();
+    _textMeasurer = new TextMeasurer();
+    _movieClipAnimator = new MovieClipAnimator();
 
     _scheduler = new Scheduler();
     _actionManager = new ActionManager();
@@ -91,6 +107,9 @@ void FGUIManager::cleanupResources()
     CC_SAFE_RELEASE_NULL(_whiteTexture);
     CC_SAFE_DELETE(_renderContext);
 
+    //stops the measuring thread before the fonts it may be using are deleted
+    CC_SAFE_DELETE(_textMeasurer);
+
     for (auto &it : _fonts)
         delete it.second;
     _fonts.clear();
@@ -101,6 +120,12 @@ void FGUIManager::cleanupResources()
     PoolManager::destroyInstance();
 
     UIPackage::removeAllPackages();
+
+    CC_SAFE_DELETE(_textureResidencyManager);
+    CC_SAFE_DELETE(_textureCache);
+    CC_SAFE_DELETE(_workerPool);
+    //clips still alive after this see a null animator and skip unregistering
+    CC_SAFE_DELETE(_movieClipAnimator);
 }
 
 // switch to play-the-game mode
@@ -190,10 +215,21 @@ void FGUIManager::OnHandleCallback(IVisCallbackDataObject_cl * pData)
     if (pData->m_pSender == &Vision::Callbacks.OnFrameUpdatePreRender)
     {
         _frameCount++;
+        FGUI_PROFILE_FRAME();
 
         float dt = Vision::GetTimer()->GetTimeDifference();
-        getScheduler()->update(dt);
-        _stage->update(dt);
+        _textMeasurer->update();
+        {
+            FGUI_PROFILE_ZONE("Scheduler::update");
+            getScheduler()->update(dt);
+        }
+        {
+            FGUI_PROFILE_ZONE("Stage::update");
+            _stage->update(dt);
+        }
+        _movieClipAnimator->update(dt);
+        _textureResidencyManager->update(Vision::GetTimer()->GetTime());
+        _textureCache->update();
 
         PoolManager::getInstance()->getCurrentPool()->clear();
     }
@@ -203,6 +239,7 @@ void FGUIManager::OnHandleCallback(IVisCallbackDataObject_cl * pData)
         if (pRHDO->m_iEntryConst != VRH_GUI)
             return;
 
+        FGUI_PROFILE_ZONE("Stage::onRender");
         _renderContext->begin();
         _stage->onRender(_renderContext);
         _renderContext->end();
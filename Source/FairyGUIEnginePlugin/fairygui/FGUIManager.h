@@ -9,6 +9,11 @@ NS_FGUI_BEGIN
 class GRoot;
 class RenderContext;
 class BaseFont;
+class TextureResidencyManager;
+class TextureCache;
+class WorkerPool;
+class TextMeasurer;
+class MovieClipAnimator;
 
 class FGUI_IMPEXP FGUIManager : public IVisCallbackHandler_cl
 {
@@ -22,6 +27,11 @@ public:
     ActionManager* getActionManager();
     Scheduler* getScheduler();
     NTexture* getWhiteTexture();
+    TextureResidencyManager* getTextureResidencyManager();
+    TextureCache* getTextureCache();
+    WorkerPool* getWorkerPool();
+    TextMeasurer* getTextMeasurer();
+    MovieClipAnimator* getMovieClipAnimator();
 
     void setShowCursor(bool show);
     bool isShowCursor() const;
@@ -48,6 +58,11 @@ private:
     Scheduler* _scheduler;
     ActionManager* _actionManager;
     NTexture* _whiteTexture;
+    TextureResidencyManager* _textureResidencyManager;
+    TextureCache* _textureCache;
+    WorkerPool* _workerPool;
+    TextMeasurer* _textMeasurer;
+    MovieClipAnimator* _movieClipAnimator;
 
     RenderContext* _renderContext;
     hkUint32 _frameCount;
@@ -86,6 +101,31 @@ inline NTexture * FGUIManager::getWhiteTexture()
     return _whiteTexture;
 }
 
+inline TextureResidencyManager * FGUIManager::getTextureResidencyManager()
+{
+    return _textureResidencyManager;
+}
+
+inline TextureCache * FGUIManager::getTextureCache()
+{
+    return _textureCache;
+}
+
+inline WorkerPool * FGUIManager::getWorkerPool()
+{
+    return _workerPool;
+}
+
+inline TextMeasurer * FGUIManager::getTextMeasurer()
+{
+    return _textMeasurer;
+}
+
+inline MovieClipAnimator * FGUIManager::getMovieClipAnimator()
+{
+    return _movieClipAnimator;
+}
+
 NS_FGUI_END
 
 #endif
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "GObjectPool.h"
 #include "treeview/TreeView.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 #include "third_party/cc/CCActionManager.h"
 #include "third_party/cc/CCScheduler.h"
@@ -2,6 +2,7 @@
 #include "GLabel.h"
 #include "GTextField.h"
 #include "UIConfig.h"
+#include "StringTable.h"
 #include "FGUIManager.h"
 #include "utils/ToolSet.h"
 
@@ -40,6 +41,7 @@ GButton::~GButton()
 void GButton::setTitle(const std::string & value)
 {
     _title = value;
+    setRuntimeString(StringTable::TEXT);
     if (_titleObject != nullptr)
         _titleObject->setText((_selected && _selectedTitle.length() > 0) ? _selectedTitle : _title);
     updateGear(6);
@@ -56,6 +58,7 @@ void GButton::setIcon(const std::string & value)
 void GButton::setSelectedTitle(const std::string & value)
 {
     _selectedTitle = value;
+    setRuntimeString(StringTable::ITEM);
     if (_titleObject != nullptr)
         _titleObject->setText((_selected && _selectedTitle.length() > 0) ? _selectedTitle : _title);
 }
@@ -418,4 +421,19 @@ void GButton::onRemoveFromStage(EventContext * context)
         onRollOut(context);
 }
 
+void GButton::applyStrings(const StringTable & strings)
+{
+    const char* p;
+
+    p = isRuntimeString(StringTable::TEXT) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::TEXT);
+    if (p)
+        setTitle(p);
+
+    p = isRuntimeString(StringTable::ITEM) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::ITEM);
+    if (p)
+        setSelectedTitle(p);
+
+    GComponent::applyStrings(strings);
+}
+
 NS_FGUI_END
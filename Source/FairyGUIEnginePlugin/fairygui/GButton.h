@@ -55,6 +55,8 @@ protected:
 protected:
     virtual void constructFromXML(TXMLElement* xml) override;
     virtual void setup_AfterAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
+    virtual bool hasLiveStrings() const override { return true; }
     virtual void handleControllerChanged(GController* c) override;
 
     void setState(const std::string& value);
@@ -37,11 +37,19 @@ const std::string& GComboBox::getTitle() const
 
 void GComboBox::setTitle(const std::string & value)
 {
+    setRuntimeString(StringTable::TEXT);
     if (_titleObject != nullptr)
         _titleObject->setText(value);
     updateGear(6);
 }
 
+std::vector<std::string>& GComboBox::getItems()
+{
+    //the items may be changed through the reference, they are not translated any more
+    setRuntimeString(StringTable::ITEM);
+    return _items;
+}
+
 const std::string& GComboBox::getIcon() const
 {
     if (_iconObject != nullptr)
@@ -376,4 +384,31 @@ void GComboBox::onPopupWinClosed(EventContext* context)
     setCurrentState();
 }
 
+void GComboBox::applyStrings(const StringTable & strings)
+{
+    const char* p;
+
+    int cnt = (int)_items.size();
+    for (int i = 0; i < cnt && !isRuntimeString(StringTable::ITEM); i++)
+    {
+        p = strings.find(_stringsComponent, _stringsElement, StringTable::ITEM + i);
+        if (p)
+        {
+            _items[i] = p;
+            _itemsUpdated = true;
+        }
+    }
+
+    if (_selectedIndex >= 0 && _selectedIndex < cnt)
+        setTitle(_items[_selectedIndex]);
+    else if (!isRuntimeString(StringTable::TEXT))
+    {
+        p = strings.find(_stringsComponent, _stringsElement, StringTable::TEXT);
+        if (p)
+            setTitle(p);
+    }
+
+    GComponent::applyStrings(strings);
+}
+
 NS_FGUI_END
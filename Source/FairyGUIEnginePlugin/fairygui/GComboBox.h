@@ -31,7 +31,7 @@ public:
     GController* getSelectionController() const { return _selectionController; }
     void setSelectionController(GController* value) { _selectionController = value; }
 
-    std::vector<std::string>& getItems() { return _items; }
+    std::vector<std::string>& getItems();
     std::vector<std::string>& getIcons() { return _icons; }
     std::vector<std::string>& getValues() { return _values; }
 
@@ -47,6 +47,8 @@ protected:
 protected:
     virtual void constructFromXML(TXMLElement* xml) override;
     virtual void setup_AfterAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
+    virtual bool hasLiveStrings() const override { return true; }
     virtual void handleControllerChanged(GController* c) override;
     virtual void handleGrayedChanged() override;
 
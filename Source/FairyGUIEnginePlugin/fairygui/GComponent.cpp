@@ -4,6 +4,8 @@
 #include "UIPackage.h"
 #include "GButton.h"
 #include "utils/ToolSet.h"
+#include "utils/BoundsTree.h"
+#include "utils/MemoryStats.h"
 #include "core/HitTest.h"
 
 NS_FGUI_BEGIN
@@ -17,6 +19,10 @@ GComponent::GComponent() :
     _trackBounds(false),
     _sortingChildCount(0),
     _applyingController(nullptr),
+    _boundsTree(nullptr),
+    _boundsTreeValid(false),
+    _boundsTreeUpdates(0),
+    _arena(nullptr),
     _buildingDisplayList(false),
     _alignOffset(0, 0)
 {
@@ -33,6 +39,10 @@ GComponent::~GComponent()
 
     CC_SAFE_RELEASE(_container);
     CC_SAFE_RELEASE(_scrollPane);
+    CC_SAFE_DELETE(_boundsTree);
+    //the slabs stay until the blocks of this component are freed as well
+    if (_arena != nullptr)
+        _arena->release();
 }
 
 void GComponent::handleInit()
@@ -535,6 +545,8 @@ void GComponent::setViewHeight(float value)
 
 void GComponent::setBoundsChangedFlag()
 {
+    _boundsTreeValid = false;
+
     if (_scrollPane == nullptr && !_trackBounds)
         return;
 
@@ -542,6 +554,30 @@ void GComponent::setBoundsChangedFlag()
     scheduleOnce(SCHEDULE_SELECTOR(GComponent::doUpdateBounds));
 }
 
+void GComponent::childBoundsChanged(GObject* child)
+{
+    if (_scrollPane == nullptr && !_trackBounds)
+    {
+        _boundsTreeValid = false;
+        return;
+    }
+
+    if (_boundsTreeValid)
+    {
+        //a few moves are patched into the tree, many moves in one frame are cheaper to rebuild
+        int index = child->_boundsIndex;
+        if (index >= 0 && index < _boundsTree->getCount() && index < (int)_children.size()
+            && _children.at(index) == child
+            && ++_boundsTreeUpdates <= (_boundsTree->getCount() >> 4) + 1)
+            _boundsTree->updateRect(index, child->getX(), child->getY(), child->getWidth(), child->getHeight());
+        else
+            _boundsTreeValid = false;
+    }
+
+    _boundsChanged = true;
+    scheduleOnce(SCHEDULE_SELECTOR(GComponent::doUpdateBounds));
+}
+
 void GComponent::ensureBoundsCorrect()
 {
     if (_boundsChanged)
@@ -553,30 +589,29 @@ void GComponent::updateBounds()
     float ax, ay, aw, ah;
     if (_children.size() > 0)
     {
-        ax = FLT_MAX;
-        ay = FLT_MAX;
-        float ar = -FLT_MAX, ab = -FLT_MAX;
-        float tmp;
+        if (_boundsTree == nullptr)
+            _boundsTree = new BoundsTree();
 
-        int cnt = (int)_children.size();
-        for (int i = 0; i < cnt; ++i)
+        if (!_boundsTreeValid)
         {
-            GObject* child = _children.at(i);
-            tmp = child->getX();
-            if (tmp < ax)
-                ax = tmp;
-            tmp = child->getY();
-            if (tmp < ay)
-                ay = tmp;
-            tmp = child->getX() + child->getWidth();
-            if (tmp > ar)
-                ar = tmp;
-            tmp = child->getY() + child->getHeight();
-            if (tmp > ab)
-                ab = tmp;
+            int cnt = (int)_children.size();
+            _boundsTree->reset(cnt);
+            for (int i = 0; i < cnt; ++i)
+            {
+                GObject* child = _children.at(i);
+                child->_boundsIndex = i;
+                _boundsTree->setRect(i, child->getX(), child->getY(), child->getWidth(), child->getHeight());
+            }
+            _boundsTree->build();
+            _boundsTreeValid = true;
         }
-        aw = ar - ax;
-        ah = ab - ay;
+        _boundsTreeUpdates = 0;
+
+        const VRectanglef& rect = _boundsTree->getBounds();
+        ax = rect.m_vMin.x;
+        ay = rect.m_vMin.y;
+        aw = rect.m_vMax.x - ax;
+        ah = rect.m_vMax.y - ay;
     }
     else
     {
@@ -1079,6 +1114,7 @@ void GComponent::constructFromResource(std::vector<GObject*>* objectPool, int po
     {
         child = _children.at(i);
         child->setup_AfterAdd(displayList[i]->desc);
+        child->setupStrings(_packageItem->stringsId, displayList[i]->stringsId);
         child->_underConstruct = false;
     }
 
@@ -1089,15 +1125,12 @@ void GComponent::constructFromResource(std::vector<GObject*>* objectPool, int po
         setMask(getChildById(p)->displayObject(), inverted);
     }
 
-    exml = xml->FirstChildElement("transition");
-    while (exml)
+    for (auto &data : _packageItem->transitions)
     {
         Transition* trans = new Transition(this, (int)_transitions.size());
         _transitions.pushBack(trans);
         trans->release();
-        trans->setup(exml);
-
-        exml = exml->NextSiblingElement("transition");
+        trans->setup(data);
     }
     if (!_transitions.empty())
     {
@@ -1148,5 +1181,24 @@ void GComponent::setup_AfterAdd(TXMLElement * xml)
     }
 }
 
+void GComponent::collectMemoryStats(MemoryStats & stats) const
+{
+    GObject::collectMemoryStats(stats);
+
+    if (_container != nullptr && _container != _displayObject)
+        _container->collectMemoryStats(stats);
+    stats.add(MemoryStats::OBJECTS, _children.capacity() * sizeof(GObject*));
+
+    size_t bytes = (_controllers.capacity() + _transitions.capacity()) * sizeof(void*);
+    for (auto &it : _controllers)
+        bytes += it->getMemoryUsage();
+    for (auto &it : _transitions)
+        bytes += it->getMemoryUsage();
+    stats.add(MemoryStats::CONTROLLERS_TRANSITIONS, bytes);
+
+    for (auto &child : _children)
+        child->collectMemoryStats(stats);
+}
+
 NS_FGUI_END
 
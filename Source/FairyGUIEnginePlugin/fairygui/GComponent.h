@@ -11,6 +11,8 @@
 NS_FGUI_BEGIN
 
 class GGroup;
+class BoundsTree;
+class SlabArena;
 
 class FGUI_IMPEXP GComponent : public GObject
 {
@@ -87,10 +89,12 @@ public:
     //internal use
     void childSortingOrderChanged(GObject* child, int oldValue, int newValue);
     void childStateChanged(GObject * child);
+    void childBoundsChanged(GObject* child);
     void adjustRadioGroupDepth(GObject* obj, GController* c);
 
     virtual void constructFromResource() override;
     void constructFromResource(std::vector<GObject*>* objectPool, int poolIndex);
+    virtual void collectMemoryStats(MemoryStats& stats) const override;
 
     bool _buildingDisplayList;
 
@@ -142,8 +146,13 @@ private:
 
     int _sortingChildCount;
     GController* _applyingController;
+    BoundsTree* _boundsTree;
+    bool _boundsTreeValid;
+    int _boundsTreeUpdates;
+    SlabArena* _arena;
 
     friend class ScrollPane;
+    friend class UIPackage;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(GComponent);
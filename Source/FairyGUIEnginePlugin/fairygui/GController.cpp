@@ -1,6 +1,7 @@
 #include "GController.h"
 #include "GComponent.h"
 #include "utils/ToolSet.h"
+#include "utils/MemoryStats.h"
 #include "controller_action/ControllerAction.h"
 
 NS_FGUI_BEGIN
@@ -95,6 +96,18 @@ bool GController::hasPage(const std::string & aName) const
     return ToolSet::findInStringArray(_pageNames, aName) != -1;
 }
 
+size_t GController::getMemoryUsage() const
+{
+    size_t bytes = sizeof(GController) + MemoryStats::stringBytes(_name)
+        + (_pageIds.capacity() + _pageNames.capacity()) * sizeof(std::string)
+        + _actions.capacity() * sizeof(ControllerAction*) + getListenerMemoryUsage();
+    for (auto &it : _pageIds)
+        bytes += MemoryStats::stringBytes(it);
+    for (auto &it : _pageNames)
+        bytes += MemoryStats::stringBytes(it);
+    return bytes;
+}
+
 int GController::getPageIndexById(const std::string & value) const
 {
     return ToolSet::findInStringArray(_pageIds, value);
@@ -41,6 +41,7 @@ public:
 
     int getPageCount() const;
     bool hasPage(const std::string& aName) const;
+    size_t getMemoryUsage() const;
     int getPageIndexById(const std::string& value) const;
     const std::string& getPageNameById(const std::string& value) const;
     const std::string& getPageId(int index) const;
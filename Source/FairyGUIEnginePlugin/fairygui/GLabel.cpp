@@ -2,6 +2,7 @@
 #include "GButton.h"
 #include "GTextField.h"
 #include "GTextInput.h"
+#include "StringTable.h"
 #include "utils/ToolSet.h"
 
 NS_FGUI_BEGIN
@@ -18,6 +19,7 @@ GLabel::~GLabel()
 void GLabel::setTitle(const std::string & value)
 {
     _title = value;
+    setRuntimeString(StringTable::TEXT);
     if (_titleObject != nullptr)
         _titleObject->setText(_title);
     updateGear(6);
@@ -116,9 +118,14 @@ void GLabel::setup_AfterAdd(TXMLElement * xml)
     GTextInput* input = dynamic_cast<GTextInput*>(_titleObject);
     if (input)
     {
+        //the prompt is this label's, on the input it is not a runtime string
         p = xml->Attribute("prompt");
         if (p)
+        {
+            input->_gearLocked = true;
             input->setPrompt(p);
+            input->_gearLocked = false;
+        }
 
         if (xml->BoolAttribute("password"))
             input->setPassword(true);
@@ -137,4 +144,27 @@ void GLabel::setup_AfterAdd(TXMLElement * xml)
     }
 }
 
+void GLabel::applyStrings(const StringTable & strings)
+{
+    const char* p;
+
+    p = isRuntimeString(StringTable::TEXT) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::TEXT);
+    if (p)
+        setTitle(p);
+
+    GTextInput* input = dynamic_cast<GTextInput*>(_titleObject);
+    if (input && !input->isRuntimeString(StringTable::PROMPT))
+    {
+        p = strings.find(_stringsComponent, _stringsElement, StringTable::PROMPT);
+        if (p)
+        {
+            input->_gearLocked = true;
+            input->setPrompt(p);
+            input->_gearLocked = false;
+        }
+    }
+
+    GComponent::applyStrings(strings);
+}
+
 NS_FGUI_END
\ No newline at end of file
@@ -33,6 +33,8 @@ protected:
 protected:
     virtual void constructFromXML(TXMLElement* xml) override;
     virtual void setup_AfterAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
+    virtual bool hasLiveStrings() const override { return true; }
 
 private:
     GObject* _titleObject;
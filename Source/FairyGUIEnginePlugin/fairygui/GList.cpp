@@ -3,12 +3,54 @@
 #include "UIPackage.h"
 #include "GObjectPool.h"
 #include "UIConfig.h"
+#include "FGUIManager.h"
+#include "core/TextMeasurer.h"
 #include "utils/ToolSet.h"
+#include "utils/Profiler.h"
+
+#include <chrono>
 
 NS_FGUI_BEGIN
 
+//how many frames of the current scrolling speed the overscan reaches ahead, at most a view
+static const float OVERSCAN_FRAMES = 4;
+
+static int s_renderBudgetFrame = -1;
+static double s_renderBudgetUsed = 0;
+
+static double getMilliseconds()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//UIConfig::virtualListRenderBudget is shared by all the virtual lists of a frame
+static bool isRenderBudgetExceeded()
+{
+    if (UIConfig::virtualListRenderBudget <= 0)
+        return false;
+
+    int frame = FGUIManager::GlobalManager().getFrameCount();
+    if (frame != s_renderBudgetFrame)
+    {
+        s_renderBudgetFrame = frame;
+        s_renderBudgetUsed = 0;
+    }
+    return s_renderBudgetUsed >= UIConfig::virtualListRenderBudget;
+}
+
+static void chargeRenderBudget(double startTime)
+{
+    int frame = FGUIManager::GlobalManager().getFrameCount();
+    if (frame != s_renderBudgetFrame)
+    {
+        s_renderBudgetFrame = frame;
+        s_renderBudgetUsed = 0;
+    }
+    s_renderBudgetUsed += getMilliseconds() - startTime;
+}
+
 GList::ItemInfo::ItemInfo() :
-    obj(nullptr), updateFlag(0), selected(false), size(0, 0)
+    obj(nullptr), updateFlag(0), placeholder(false)
 {
 }
 
@@ -37,6 +79,12 @@ GList::GList() :
     _virtualListChanged(false),
     _eventLocked(false),
     _enterCounter(0),
+    _estimatedSizeDelta(0),
+    _estimatedPosDelta(0),
+    _lastScrollPos(0),
+    _renderPending(false),
+    _budgetOverrunCount(0),
+    _budgetOverrunFrame(-1),
     _itemInfoVer(0)
 {
     _trackBounds = true;
@@ -191,6 +239,10 @@ void GList::removeChildAt(int index)
     child->removeClickListener(EventTag(this));
     child->removeListener(UIEventType::TouchBegin, EventTag(this));
     child->removeListener(UIEventType::RightClick, EventTag(this));
+    if (!_itemKeys.empty())
+        _itemKeys.erase(child);
+    if (!_packageItems.empty())
+        _packageItems.erase(child);
 
     GComponent::removeChildAt(index);
 }
@@ -225,19 +277,10 @@ int GList::getSelectedIndex() const
 {
     if (_virtual)
     {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
-        {
-            const ItemInfo& ii = _virtualItems[i];
-            if ((dynamic_cast<GButton*>(ii.obj) != nullptr && ((GButton*)ii.obj)->isSelected())
-                || (ii.obj == nullptr && ii.selected))
-            {
-                if (_loop)
-                    return i % _numItems;
-                else
-                    return i;
-            }
-        }
+        std::vector<int> selection;
+        getVirtualSelection(selection);
+        if (!selection.empty())
+            return selection[0];
     }
     else
     {
@@ -273,25 +316,7 @@ void GList::getSelection(std::vector<int>& result)
 {
     result.clear();
     if (_virtual)
-    {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
-        {
-            ItemInfo& ii = _virtualItems[i];
-            if ((dynamic_cast<GButton*>(ii.obj) != nullptr && ((GButton*)ii.obj)->isSelected())
-                || (ii.obj == nullptr && ii.selected))
-            {
-                int j = i;
-                if (_loop)
-                {
-                    j = i % _numItems;
-                    if (std::find(result.cbegin(), result.cend(), j) != result.cend())
-                        continue;
-                }
-                result.push_back(j);
-            }
-        }
-    }
+        getVirtualSelection(result);
     else
     {
         int cnt = (int)_children.size();
@@ -321,10 +346,10 @@ void GList::addSelection(int index, bool scrollItToView)
     GButton* obj = nullptr;
     if (_virtual)
     {
-        ItemInfo& ii = _virtualItems[index];
-        if (ii.obj != nullptr)
-            obj = ii.obj->as<GButton>();
-        ii.selected = true;
+        GObject* itemObj = findItemObject(index);
+        if (itemObj != nullptr)
+            obj = itemObj->as<GButton>();
+        setItemSelected(index, true);
     }
     else
         obj = getChildAt(index)->as<GButton>();
@@ -344,10 +369,10 @@ void GList::removeSelection(int index)
     GButton *obj = nullptr;
     if (_virtual)
     {
-        ItemInfo& ii = _virtualItems[index];
-        if (ii.obj != nullptr)
-            obj = ii.obj->as<GButton>();
-        ii.selected = false;
+        GObject* itemObj = findItemObject(index);
+        if (itemObj != nullptr)
+            obj = itemObj->as<GButton>();
+        setItemSelected(index, false);
     }
     else
         obj = getChildAt(index)->as<GButton>();
@@ -360,14 +385,13 @@ void GList::clearSelection()
 {
     if (_virtual)
     {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
+        for (auto &it : _virtualItems)
         {
-            ItemInfo& ii = _virtualItems[i];
+            ItemInfo& ii = it.second;
             if (dynamic_cast<GButton*>(ii.obj))
                 ((GButton*)ii.obj)->setSelected(false);
-            ii.selected = false;
         }
+        _selectedItems.assign(_selectedItems.size(), false);
     }
     else
     {
@@ -385,17 +409,23 @@ void GList::clearSelectionExcept(GObject * g)
 {
     if (_virtual)
     {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
+        int keepIndex = -1;
+        for (auto &it : _virtualItems)
         {
-            ItemInfo& ii = _virtualItems[i];
+            ItemInfo& ii = it.second;
             if (ii.obj != g)
             {
                 if (dynamic_cast<GButton*>(ii.obj))
                     ((GButton*)ii.obj)->setSelected(false);
-                ii.selected = false;
             }
+            else
+                keepIndex = it.first;
         }
+
+        bool keep = keepIndex != -1 && isItemSelected(keepIndex);
+        _selectedItems.assign(_selectedItems.size(), false);
+        if (keep)
+            setItemSelected(keepIndex, true);
     }
     else
     {
@@ -416,17 +446,16 @@ void GList::selectAll()
     int last = -1;
     if (_virtual)
     {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
+        for (auto &it : _virtualItems)
         {
-            ItemInfo& ii = _virtualItems[i];
+            ItemInfo& ii = it.second;
             if (dynamic_cast<GButton*>(ii.obj) && !((GButton*)ii.obj)->isSelected())
             {
                 ((GButton*)ii.obj)->setSelected(true);
-                last = i;
+                last = MAX(last, it.first);
             }
-            ii.selected = true;
         }
+        _selectedItems.assign(_selectedItems.size(), true);
     }
     else
     {
@@ -454,18 +483,17 @@ void GList::selectReverse()
     int last = -1;
     if (_virtual)
     {
-        int cnt = _realNumItems;
-        for (int i = 0; i < cnt; i++)
+        for (auto &it : _virtualItems)
         {
-            ItemInfo& ii = _virtualItems[i];
+            ItemInfo& ii = it.second;
             if (dynamic_cast<GButton*>(ii.obj))
             {
                 ((GButton*)ii.obj)->setSelected(!((GButton*)ii.obj)->isSelected());
                 if (((GButton*)ii.obj)->isSelected())
-                    last = i;
+                    last = MAX(last, it.first);
             }
-            ii.selected = !ii.selected;
         }
+        _selectedItems.flip();
     }
     else
     {
@@ -717,13 +745,15 @@ void GList::setSelectionOnEvent(GObject * item, InputEvent * evt)
                     max = hkvMath::Min<int>(max, getNumItems() - 1);
                     if (_virtual)
                     {
-                        for (int i = min; i <= max; i++)
+                        for (auto &it : _virtualItems)
                         {
-                            ItemInfo& ii = _virtualItems[i];
-                            if (dynamic_cast<GButton*>(ii.obj))
+                            ItemInfo& ii = it.second;
+                            int i = it.first % _numItems;
+                            if (i >= min && i <= max && dynamic_cast<GButton*>(ii.obj))
                                 ((GButton*)ii.obj)->setSelected(true);
-                            ii.selected = true;
                         }
+                        for (int i = min; i <= max; i++)
+                            setItemSelected(i, true);
                     }
                     else
                     {
@@ -879,34 +909,30 @@ void GList::scrollToView(int index, bool ani, bool setFirst)
 
         checkVirtualList();
 
-        CCASSERT(index >= 0 && index < (int)_virtualItems.size(), "Invalid child index");
+        CCASSERT(index >= 0 && index < _realNumItems, "Invalid child index");
 
         if (_loop)
             index = (int)floor(_firstIndex / _numItems) * _numItems + index;
 
         VRectanglef rect;
-        ItemInfo& ii = _virtualItems[index];
+        const hkvVec2& size = getItemSize(index);
         if (_layout == ListLayoutType::SINGLE_COLUMN || _layout == ListLayoutType::FLOW_HORIZONTAL)
         {
-            float pos = 0;
-            for (int i = 0; i < index; i += _curLineItemCount)
-                pos += _virtualItems[i].size.y + _lineGap;
-            rect.Set(0, pos, _itemSize.x, pos + ii.size.y);
+            float pos = sumItemSizes(0, index, _curLineItemCount, true, _lineGap);
+            rect.Set(0, pos, _itemSize.x, pos + size.y);
         }
         else if (_layout == ListLayoutType::SINGLE_ROW || _layout == ListLayoutType::FLOW_VERTICAL)
         {
-            float pos = 0;
-            for (int i = 0; i < index; i += _curLineItemCount)
-                pos += _virtualItems[i].size.x + _columnGap;
-            rect.Set(pos, 0, pos + ii.size.x, _itemSize.y);
+            float pos = sumItemSizes(0, index, _curLineItemCount, false, _columnGap);
+            rect.Set(pos, 0, pos + size.x, _itemSize.y);
         }
         else
         {
             int page = index / (_curLineItemCount * _curLineItemCount2);
-            rect.m_vMin.x = page * getViewWidth() + (index % _curLineItemCount) * (ii.size.x + _columnGap);
-            rect.m_vMin.y = (index / _curLineItemCount) % _curLineItemCount2 * (ii.size.y + _lineGap);
-            rect.m_vMax.x = rect.m_vMin.x + ii.size.x;
-            rect.m_vMax.y = rect.m_vMin.y + ii.size.y;
+            rect.m_vMin.x = page * getViewWidth() + (index % _curLineItemCount) * (size.x + _columnGap);
+            rect.m_vMin.y = (index / _curLineItemCount) % _curLineItemCount2 * (size.y + _lineGap);
+            rect.m_vMax.x = rect.m_vMin.x + size.x;
+            rect.m_vMax.y = rect.m_vMin.y + size.y;
         }
 
         setFirst = true;
@@ -932,17 +958,19 @@ int GList::childIndexToItemIndex(int index)
 
     if (_layout == ListLayoutType::PAGINATION)
     {
-        for (int i = _firstIndex; i < _realNumItems; i++)
+        std::vector<int> indices;
+        for (auto &it : _virtualItems)
         {
-            if (_virtualItems[i].obj != nullptr)
-            {
-                index--;
-                if (index < 0)
-                    return i;
-            }
+            if (it.first >= _firstIndex && it.first < _realNumItems && it.second.obj != nullptr)
+                indices.push_back(it.first);
+        }
+        if (index < (int)indices.size())
+        {
+            std::nth_element(indices.begin(), indices.begin() + index, indices.end());
+            return indices[index];
         }
 
-        return index;
+        return index - (int)indices.size();
     }
     else
     {
@@ -961,7 +989,8 @@ int GList::itemIndexToChildIndex(int index)
 
     if (_layout == ListLayoutType::PAGINATION)
     {
-        return getChildIndex(_virtualItems[index].obj);
+        auto it = _virtualItems.find(index);
+        return getChildIndex(it != _virtualItems.end() ? it->second.obj : nullptr);
     }
     else
     {
@@ -1057,22 +1086,10 @@ void GList::setNumItems(int value)
         else
             _realNumItems = _numItems;
 
-        int oldCount = (int)_virtualItems.size();
-        if (_realNumItems > oldCount)
-        {
-            for (int i = oldCount; i < _realNumItems; i++)
-            {
-                ItemInfo ii;
-                ii.size = _itemSize;
-
-                _virtualItems.push_back(ii);
-            }
-        }
-        else
-        {
-            for (int i = _realNumItems; i < oldCount; i++)
-                _virtualItems[i].selected = false;
-        }
+        //Items are _itemSize and not selected unless recorded otherwise, so nothing is
+        //allocated per item. Removed items forget their size and selection.
+        _itemSizes.erase(_itemSizes.lower_bound(_numItems), _itemSizes.end());
+        _selectedItems.resize(_numItems, false);
 
         if (_virtualListChanged != 0)
             scheduleOnce(SCHEDULE_SELECTOR(GList::doRefreshVirtualList));
@@ -1098,6 +1115,9 @@ void GList::setNumItems(int value)
             removeChildrenToPool(value, cnt);
         }
 
+        //every child is rendered again, the keys of setItems no longer describe them
+        _itemKeys.clear();
+
         if (itemRenderer != nullptr)
         {
             for (int i = 0; i < value; i++)
@@ -1106,6 +1126,76 @@ void GList::setNumItems(int value)
     }
 }
 
+void GList::setItems(const std::vector<ItemKey>& items)
+{
+    CCASSERT(!_virtual, "FairyGUI: setItems is for non virtual lists, use setNumItems");
+
+    std::unordered_map<std::string, GObject*> keyed;
+    std::vector<GObject*> unkeyed;
+    for (auto &it : _children)
+    {
+        auto ki = _itemKeys.find(it);
+        if (ki == _itemKeys.end() || !keyed.insert(std::make_pair(ki->second.key, it)).second)
+            unkeyed.push_back(it);
+    }
+
+    int cnt = (int)items.size();
+    std::vector<GObject*> objs(cnt, nullptr);
+    std::vector<bool> changed(cnt, true);
+    for (int i = 0; i < cnt; i++)
+    {
+        auto it = keyed.find(items[i].key);
+        if (it != keyed.end())
+        {
+            objs[i] = it->second;
+            changed[i] = _itemKeys[it->second].version != items[i].version;
+            keyed.erase(it);
+        }
+    }
+    for (auto &it : keyed)
+        unkeyed.push_back(it.second);
+
+    //children whose keys are gone take the new items if they are all of the default type,
+    //the others go back to the pool
+    size_t reused = 0;
+    if (itemProvider == nullptr)
+    {
+        for (int i = 0; i < cnt && reused < unkeyed.size(); i++)
+        {
+            if (objs[i] == nullptr)
+                objs[i] = unkeyed[reused++];
+        }
+    }
+    for (size_t i = reused; i < unkeyed.size(); i++)
+        removeChildToPool(unkeyed[i]);
+
+    //structure first, the bounds are updated once for all of it
+    for (int i = 0; i < cnt; i++)
+    {
+        GObject* obj = objs[i];
+        if (obj == nullptr)
+        {
+            obj = getFromPool(itemProvider != nullptr ? itemProvider(i) : STD_STRING_EMPTY);
+            objs[i] = obj;
+            addChildAt(obj, i);
+        }
+        else if (_children.at(i) != obj)
+            setChildIndex(obj, i);
+
+        if (changed[i])
+            _itemKeys[obj] = items[i];
+    }
+
+    if (itemRenderer != nullptr)
+    {
+        for (int i = 0; i < cnt; i++)
+        {
+            if (changed[i])
+                itemRenderer(i, objs[i]);
+        }
+    }
+}
+
 void GList::refreshVirtualList()
 {
     CCASSERT(_virtual, "FairyGUI: not virtual list");
@@ -1113,6 +1203,259 @@ void GList::refreshVirtualList()
     setVirtualListChangedFlag(false);
 }
 
+void GList::prefetchItemSizes(int startIndex, int count)
+{
+    if (!_virtual || itemSizeProvider == nullptr || _layout != ListLayoutType::SINGLE_COLUMN)
+        return;
+
+    TextMeasurer* measurer = FGUIManager::GlobalManager().getTextMeasurer();
+    int endIndex = MIN(startIndex + count, _realNumItems);
+    for (int i = MAX(startIndex, 0); i < endIndex; i++)
+    {
+        if (_itemSizes.find(i % _numItems) != _itemSizes.end() || _virtualItems.find(i) != _virtualItems.end())
+            continue;
+
+        ItemSizeRequest request;
+        request.width = _scrollPane->getViewSize().x;
+        request.extraHeight = 0;
+        if (!itemSizeProvider(i % _numItems, request))
+        {
+            setItemSize(i, _itemSize, 2);
+            continue;
+        }
+
+        setItemSize(i, _itemSize, 1);
+        float extraHeight = request.extraHeight;
+        WeakPtr wptr(this);
+        measurer->measure(request.text, request.format, request.width, [wptr, i, extraHeight](const hkvVec2& size)
+        {
+            GList* list = wptr.ptr<GList>();
+            if (list != nullptr)
+                list->onItemSizeMeasured(i, ceil(size.y + extraHeight));
+        });
+    }
+}
+
+void GList::onItemSizeMeasured(int index, float height)
+{
+    if (index >= _realNumItems)
+        return;
+
+    auto it = _itemSizes.find(index % _numItems);
+    if (it == _itemSizes.end() || it->second.state != 1)
+        return;
+
+    it->second.state = 2;
+    if (it->second.size.y == height)
+        return;
+
+    //Every copy of the item in a loop list changes. The copies above the view would move the
+    //visible rows, the scroll position follows them instead.
+    float delta = height - it->second.size.y;
+    int above = countCopiesBefore(index, _firstIndex);
+    if (index < _firstIndex)
+        above++;
+    _estimatedSizeDelta += delta * getItemCopyCount();
+    _estimatedPosDelta += delta * above;
+    it->second.size.y = height;
+    scheduleOnce(SCHEDULE_SELECTOR(GList::applyItemSizeEstimates));
+}
+
+void GList::applyItemSizeEstimates(float)
+{
+    //one content size change for all the results of a frame
+    if (_estimatedSizeDelta != 0 || _estimatedPosDelta != 0)
+    {
+        _scrollPane->changeContentSizeOnScrolling(0, _estimatedSizeDelta, 0, _estimatedPosDelta);
+        _estimatedSizeDelta = 0;
+        _estimatedPosDelta = 0;
+    }
+}
+
+const hkvVec2& GList::getItemSize(int index) const
+{
+    auto it = _itemSizes.find(index % _numItems);
+    if (it != _itemSizes.end())
+        return it->second.size;
+    else
+        return _itemSize;
+}
+
+void GList::setItemSize(int index, const hkvVec2& size, uint8_t state)
+{
+    //a rendered item of the default size needs no record
+    if (state == 3 && size == _itemSize)
+        _itemSizes.erase(index % _numItems);
+    else
+    {
+        ItemSize& is = _itemSizes[index % _numItems];
+        is.size = size;
+        is.state = state;
+    }
+}
+
+int GList::nextSizedIndex(int index) const
+{
+    //the first index at or after index with a record, each record stands for its item in every copy
+    if (_numItems == 0)
+        return _realNumItems;
+
+    for (int copyStart = index - index % _numItems; copyStart < _realNumItems; copyStart += _numItems)
+    {
+        auto it = _itemSizes.lower_bound(MAX(index - copyStart, 0));
+        if (it != _itemSizes.end())
+            return copyStart + it->first;
+    }
+    return _realNumItems;
+}
+
+int GList::countCopiesBefore(int index, int endIndex) const
+{
+    //the other copies of the item at index that come before endIndex, always 0 out of a loop list
+    int cnt = 0;
+    for (int i = index % _numItems; i < endIndex && i < _realNumItems; i += _numItems)
+    {
+        if (i != index)
+            cnt++;
+    }
+    return cnt;
+}
+
+float GList::sumItemSizes(int startIndex, int endIndex, int step, bool vertical, float gap) const
+{
+    //Sum of size + gap of the items startIndex, startIndex + step, ... before endIndex.
+    //Counted as if all were _itemSize, then corrected by the recorded sizes.
+    if (endIndex <= startIndex)
+        return 0;
+
+    int count = (endIndex - startIndex + step - 1) / step;
+    float ret = count * ((vertical ? _itemSize.y : _itemSize.x) + gap);
+    for (int i = nextSizedIndex(startIndex); i < endIndex; i = nextSizedIndex(i + 1))
+    {
+        if ((i - startIndex) % step == 0)
+        {
+            const hkvVec2& size = getItemSize(i);
+            ret += vertical ? (size.y - _itemSize.y) : (size.x - _itemSize.x);
+        }
+    }
+
+    return ret;
+}
+
+int GList::getLineOnPos(float & pos, bool vertical, float gap) const
+{
+    //Same result as walking the lines from the top, but a run of lines without a record is
+    //skipped in one step, so the cost is the number of recorded sizes before pos.
+    int step = _curLineItemCount;
+    float defaultSize = vertical ? _itemSize.y : _itemSize.x;
+    float lineSize = defaultSize + gap;
+    float testGap = gap > 0 ? gap : 0;
+    float pos2 = 0;
+    int i = 0;
+    while (i < _realNumItems)
+    {
+        int next = nextSizedIndex(i);
+        while (next < _realNumItems && next % step != 0)
+            next = nextSizedIndex(next + 1);
+
+        int lines = (next - i + step - 1) / step;
+        if (lines > 0)
+        {
+            int k;
+            if (lineSize > 0)
+            {
+                float first = (pos - pos2 - defaultSize - testGap) / lineSize;
+                k = first < 0 ? 0 : (first >= lines ? lines : (int)first + 1);
+                //against rounding, k is the first line whose end passes pos
+                while (k > 0 && pos2 + (k - 1) * lineSize + defaultSize + testGap > pos)
+                    k--;
+                while (k < lines && pos2 + k * lineSize + defaultSize + testGap <= pos)
+                    k++;
+            }
+            else
+                k = defaultSize + testGap > pos - pos2 ? 0 : lines;
+
+            if (k < lines)
+            {
+                pos = pos2 + k * lineSize;
+                return i + k * step;
+            }
+            pos2 += lines * lineSize;
+            i += lines * step;
+        }
+
+        if (next >= _realNumItems)
+            break;
+
+        const hkvVec2& size = getItemSize(next);
+        float pos3 = pos2 + (vertical ? size.y : size.x);
+        if (pos3 + testGap > pos)
+        {
+            pos = pos2;
+            return i;
+        }
+        pos2 = pos3 + gap;
+        i += step;
+    }
+
+    pos = pos2;
+    return _realNumItems - step;
+}
+
+GObject* GList::findItemObject(int itemIndex) const
+{
+    for (auto &it : _virtualItems)
+    {
+        if (it.second.obj != nullptr && it.first % _numItems == itemIndex)
+            return it.second.obj;
+    }
+
+    return nullptr;
+}
+
+void GList::getVirtualSelection(std::vector<int>& result) const
+{
+    //the buttons of the rendered items hold their current selection
+    std::unordered_map<int, bool> rendered;
+    for (auto &it : _virtualItems)
+    {
+        GButton* button = dynamic_cast<GButton*>(it.second.obj);
+        if (button != nullptr)
+        {
+            bool& selected = rendered[it.first % _numItems];
+            selected = selected || button->isSelected();
+        }
+    }
+
+    for (int i = 0; i < _numItems; i++)
+    {
+        if (_selectedItems[i])
+        {
+            auto it = rendered.find(i);
+            if (it == rendered.end() || it->second)
+                result.push_back(i);
+        }
+    }
+    for (auto &it : rendered)
+    {
+        if (it.second && !_selectedItems[it.first])
+            result.push_back(it.first);
+    }
+
+    std::sort(result.begin(), result.end());
+}
+
+void GList::removeEmptyItemInfos()
+{
+    for (auto it = _virtualItems.begin(); it != _virtualItems.end();)
+    {
+        if (it->second.obj == nullptr)
+            it = _virtualItems.erase(it);
+        else
+            ++it;
+    }
+}
+
 hkvVec2 GList::getSnappingPosition(const hkvVec2 & pt)
 {
     if (_virtual)
@@ -1121,20 +1464,20 @@ hkvVec2 GList::getSnappingPosition(const hkvVec2 & pt)
         if (_layout == ListLayoutType::SINGLE_COLUMN || _layout == ListLayoutType::FLOW_HORIZONTAL)
         {
             int index = getIndexOnPos1(ret.y, false);
-            if (index < (int)_virtualItems.size() && pt.y - ret.y > _virtualItems[index].size.y / 2 && index < _realNumItems)
-                ret.y += _virtualItems[index].size.y + _lineGap;
+            if (index < _realNumItems && pt.y - ret.y > getItemSize(index).y / 2)
+                ret.y += getItemSize(index).y + _lineGap;
         }
         else if (_layout == ListLayoutType::SINGLE_ROW || _layout == ListLayoutType::FLOW_VERTICAL)
         {
             int index = getIndexOnPos2(ret.x, false);
-            if (index < (int)_virtualItems.size() && pt.x - ret.x > _virtualItems[index].size.x / 2 && index < _realNumItems)
-                ret.x += _virtualItems[index].size.x + _columnGap;
+            if (index < _realNumItems && pt.x - ret.x > getItemSize(index).x / 2)
+                ret.x += getItemSize(index).x + _columnGap;
         }
         else
         {
             int index = getIndexOnPos3(ret.x, false);
-            if (index < (int)_virtualItems.size() && pt.x - ret.x > _virtualItems[index].size.x / 2 && index < _realNumItems)
-                ret.x += _virtualItems[index].size.x + _columnGap;
+            if (index < _realNumItems && pt.x - ret.x > getItemSize(index).x / 2)
+                ret.x += getItemSize(index).x + _columnGap;
         }
 
         return ret;
@@ -1167,6 +1510,8 @@ void GList::doRefreshVirtualList(float)
     bool layoutChanged = _virtualListChanged == 2;
     _virtualListChanged = 0;
     _eventLocked = true;
+    //the content size is computed from the item sizes below, pending estimates are included
+    _estimatedSizeDelta = 0;
 
     if (layoutChanged)
     {
@@ -1222,8 +1567,7 @@ void GList::doRefreshVirtualList(float)
         int len2 = hkvMath::Min<int>(_curLineItemCount, _realNumItems);
         if (_layout == ListLayoutType::SINGLE_COLUMN || _layout == ListLayoutType::FLOW_HORIZONTAL)
         {
-            for (int i = 0; i < len; i += _curLineItemCount)
-                ch += _virtualItems[i].size.y + _lineGap;
+            ch = sumItemSizes(0, len, _curLineItemCount, true, _lineGap);
             if (ch > 0)
                 ch -= _lineGap;
 
@@ -1231,16 +1575,14 @@ void GList::doRefreshVirtualList(float)
                 cw = _scrollPane->getViewSize().x;
             else
             {
-                for (int i = 0; i < len2; i++)
-                    cw += _virtualItems[i].size.x + _columnGap;
+                cw = sumItemSizes(0, len2, 1, false, _columnGap);
                 if (cw > 0)
                     cw -= _columnGap;
             }
         }
         else if (_layout == ListLayoutType::SINGLE_ROW || _layout == ListLayoutType::FLOW_VERTICAL)
         {
-            for (int i = 0; i < len; i += _curLineItemCount)
-                cw += _virtualItems[i].size.x + _columnGap;
+            cw = sumItemSizes(0, len, _curLineItemCount, false, _columnGap);
             if (cw > 0)
                 cw -= _columnGap;
 
@@ -1248,8 +1590,7 @@ void GList::doRefreshVirtualList(float)
                 ch = _scrollPane->getViewSize().y;
             else
             {
-                for (int i = 0; i < len2; i++)
-                    ch += _virtualItems[i].size.y + _lineGap;
+                ch = sumItemSizes(0, len2, 1, true, _lineGap);
                 if (ch > 0)
                     ch -= _lineGap;
             }
@@ -1290,7 +1631,7 @@ int GList::getIndexOnPos1(float & pos, bool forceUpdate)
         {
             for (int i = _firstIndex - _curLineItemCount; i >= 0; i -= _curLineItemCount)
             {
-                pos2 -= (_virtualItems[i].size.y + _lineGap);
+                pos2 -= (getItemSize(i).y + _lineGap);
                 if (pos2 <= pos)
                 {
                     pos = pos2;
@@ -1306,7 +1647,7 @@ int GList::getIndexOnPos1(float & pos, bool forceUpdate)
             float testGap = _lineGap > 0 ? _lineGap : 0;
             for (int i = _firstIndex; i < _realNumItems; i += _curLineItemCount)
             {
-                float pos3 = pos2 + _virtualItems[i].size.y;
+                float pos3 = pos2 + getItemSize(i).y;
                 if (pos3 + testGap > pos)
                 {
                     pos = pos2;
@@ -1320,23 +1661,7 @@ int GList::getIndexOnPos1(float & pos, bool forceUpdate)
         }
     }
     else
-    {
-        float pos2 = 0;
-        float testGap = _lineGap > 0 ? _lineGap : 0;
-        for (int i = 0; i < _realNumItems; i += _curLineItemCount)
-        {
-            float pos3 = pos2 + _virtualItems[i].size.y;
-            if (pos3 + testGap > pos)
-            {
-                pos = pos2;
-                return i;
-            }
-            pos2 = pos3 + _lineGap;
-        }
-
-        pos = pos2;
-        return _realNumItems - _curLineItemCount;
-    }
+        return getLineOnPos(pos, true, _lineGap);
 }
 
 int GList::getIndexOnPos2(float & pos, bool forceUpdate)
@@ -1354,7 +1679,7 @@ int GList::getIndexOnPos2(float & pos, bool forceUpdate)
         {
             for (int i = _firstIndex - _curLineItemCount; i >= 0; i -= _curLineItemCount)
             {
-                pos2 -= (_virtualItems[i].size.x + _columnGap);
+                pos2 -= (getItemSize(i).x + _columnGap);
                 if (pos2 <= pos)
                 {
                     pos = pos2;
@@ -1370,7 +1695,7 @@ int GList::getIndexOnPos2(float & pos, bool forceUpdate)
             float testGap = _columnGap > 0 ? _columnGap : 0;
             for (int i = _firstIndex; i < _realNumItems; i += _curLineItemCount)
             {
-                float pos3 = pos2 + _virtualItems[i].size.x;
+                float pos3 = pos2 + getItemSize(i).x;
                 if (pos3 + testGap > pos)
                 {
                     pos = pos2;
@@ -1384,23 +1709,7 @@ int GList::getIndexOnPos2(float & pos, bool forceUpdate)
         }
     }
     else
-    {
-        float pos2 = 0;
-        float testGap = _columnGap > 0 ? _columnGap : 0;
-        for (int i = 0; i < _realNumItems; i += _curLineItemCount)
-        {
-            float pos3 = pos2 + _virtualItems[i].size.x;
-            if (pos3 + testGap > pos)
-            {
-                pos = pos2;
-                return i;
-            }
-            pos2 = pos3 + _columnGap;
-        }
-
-        pos = pos2;
-        return _realNumItems - _curLineItemCount;
-    }
+        return getLineOnPos(pos, false, _columnGap);
 }
 
 int GList::getIndexOnPos3(float & pos, bool forceUpdate)
@@ -1418,7 +1727,7 @@ int GList::getIndexOnPos3(float & pos, bool forceUpdate)
     float testGap = _columnGap > 0 ? _columnGap : 0;
     for (int i = 0; i < _curLineItemCount; i++)
     {
-        float pos3 = pos2 + _virtualItems[startIndex + i].size.x;
+        float pos3 = pos2 + getItemSize(startIndex + i).x;
         if (pos3 + testGap > pos)
         {
             pos = pos2;
@@ -1457,18 +1766,35 @@ void GList::handleScroll(bool forceUpdate)
 
 void GList::handleScroll1(bool forceUpdate)
 {
+    FGUI_PROFILE_ZONE("GList::handleScroll1");
     _enterCounter++;
     if (_enterCounter > 3)
         return;
 
-    float pos = _scrollPane->getScrollingPosY();
-    float max = pos + _scrollPane->getViewSize().y;
-    bool end = max == _scrollPane->getContentSize().y;
+    float viewPos = _scrollPane->getScrollingPosY();
+    float viewMax = viewPos + _scrollPane->getViewSize().y;
+    bool end = viewMax == _scrollPane->getContentSize().y;
+
+    //the rows ahead in the scrolling direction are rendered before they come into view
+    float pos = viewPos;
+    float max = viewMax;
+    if (UIConfig::virtualListOverscan > 0)
+    {
+        float speed = viewPos - _lastScrollPos;
+        float lead = MIN(MAX(UIConfig::virtualListOverscan, std::abs(speed) * OVERSCAN_FRAMES), _scrollPane->getViewSize().y);
+        if (speed < 0)
+            pos = MAX(pos - lead, 0);
+        else
+            max += lead;
+    }
+    _lastScrollPos = viewPos;
 
     int newFirstIndex = getIndexOnPos1(pos, forceUpdate);
-    if (newFirstIndex == _firstIndex && !forceUpdate)
+    if (newFirstIndex == _firstIndex && !forceUpdate && !_renderPending)
         return;
 
+    _renderPending = false;
+
     int oldFirstIndex = _firstIndex;
     _firstIndex = newFirstIndex;
     int curIndex = newFirstIndex;
@@ -1479,29 +1805,47 @@ void GList::handleScroll1(bool forceUpdate)
     float curX = 0, curY = pos;
     bool needRender;
     float deltaSize = 0;
-    float firstItemDeltaSize = 0;
+    float aboveViewDeltaSize = 0;
     std::string url = _defaultItem;
     int partSize = (int)((_scrollPane->getViewSize().x - _columnGap * (_curLineItemCount - 1)) / _curLineItemCount);
+    double startTime = 0;
 
     _itemInfoVer++;
     while (curIndex < _realNumItems && (end || curY < max))
     {
         ItemInfo& ii = _virtualItems[curIndex];
 
-        if (ii.obj == nullptr || forceUpdate)
+        //out of budget: rows after the view wait for the next frames, the others take the
+        //placeholder if there is one
+        bool usePlaceholder = false;
+        if ((ii.obj == nullptr || ii.placeholder) && checkRenderBudget())
+        {
+            usePlaceholder = !UIConfig::virtualListPlaceholder.empty();
+            if (curY >= viewMax || usePlaceholder)
+                _renderPending = true;
+            if (curY >= viewMax)
+                break;
+        }
+
+        if (ii.obj == nullptr || forceUpdate || ii.placeholder)
         {
-            if (itemProvider != nullptr)
+            startTime = getMilliseconds();
+            if (usePlaceholder)
+                url = UIPackage::normalizeURL(UIConfig::virtualListPlaceholder);
+            else if (itemProvider != nullptr)
             {
                 url = itemProvider(curIndex % _numItems);
                 if (url.size() == 0)
                     url = _defaultItem;
                 url = UIPackage::normalizeURL(url);
             }
+            else
+                url = _defaultItem;
 
             if (ii.obj != nullptr && ii.obj->getResourceURL().compare(url) != 0)
             {
                 if (dynamic_cast<GButton*>(ii.obj))
-                    ii.selected = ((GButton*)ii.obj)->isSelected();
+                    setItemSelected(curIndex, ((GButton*)ii.obj)->isSelected());
                 removeChildToPool(ii.obj);
                 ii.obj = nullptr;
             }
@@ -1517,7 +1861,7 @@ void GList::handleScroll1(bool forceUpdate)
                     if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer && ii2.obj->getResourceURL().compare(url) == 0)
                     {
                         if (dynamic_cast<GButton*>(ii2.obj))
-                            ii2.selected = ((GButton*)ii2.obj)->isSelected();
+                            setItemSelected(j, ((GButton*)ii2.obj)->isSelected());
                         ii.obj = ii2.obj;
                         ii2.obj = nullptr;
                         if (j == reuseIndex)
@@ -1534,7 +1878,7 @@ void GList::handleScroll1(bool forceUpdate)
                     if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer && ii2.obj->getResourceURL().compare(url) == 0)
                     {
                         if (dynamic_cast<GButton*>(ii2.obj))
-                            ii2.selected = ((GButton*)ii2.obj)->isSelected();
+                            setItemSelected(j, ((GButton*)ii2.obj)->isSelected());
                         ii.obj = ii2.obj;
                         ii2.obj = nullptr;
                         if (j == reuseIndex)
@@ -1557,42 +1901,52 @@ void GList::handleScroll1(bool forceUpdate)
                     addChild(ii.obj);
             }
             if (dynamic_cast<GButton*>(ii.obj))
-                ((GButton*)ii.obj)->setSelected(ii.selected);
+                ((GButton*)ii.obj)->setSelected(isItemSelected(curIndex));
 
             needRender = true;
         }
         else
             needRender = forceUpdate;
+        ii.placeholder = usePlaceholder;
 
-        if (needRender)
+        if (needRender && ii.placeholder)
+        {
+            const hkvVec2& size = getItemSize(curIndex);
+            ii.obj->setSize(size.x, size.y);
+        }
+        else if (needRender)
         {
             if (_autoResizeItem && (_layout == ListLayoutType::SINGLE_COLUMN || _columnCount > 0))
                 ii.obj->setSize(partSize, ii.obj->getHeight(), true);
 
             itemRenderer(curIndex % _numItems, ii.obj);
+            chargeRenderBudget(startTime);
+            hkvVec2 newSize(ceil(ii.obj->getWidth()), ceil(ii.obj->getHeight()));
             if (curIndex % _curLineItemCount == 0)
             {
-                deltaSize += ceil(ii.obj->getHeight()) - ii.size.y;
-                if (curIndex == newFirstIndex && oldFirstIndex > newFirstIndex)
-                {
-                    firstItemDeltaSize = ceil(ii.obj->getHeight()) - ii.size.y;
-                }
+                //the copies of the item in a loop list take the new size too
+                float delta = newSize.y - getItemSize(curIndex).y;
+                deltaSize += delta * getItemCopyCount();
+                aboveViewDeltaSize += delta * countCopiesBefore(curIndex, newFirstIndex);
+                //every row starting above the view pushes the visible ones down, the overscan rows included
+                if (oldFirstIndex > newFirstIndex && (curIndex == newFirstIndex || curY < viewPos))
+                    aboveViewDeltaSize += delta;
             }
-            ii.size.x = ceil(ii.obj->getWidth());
-            ii.size.y = ceil(ii.obj->getHeight());
+            setItemSize(curIndex, newSize, 3);
         }
 
+        const hkvVec2& size = getItemSize(curIndex);
         ii.updateFlag = _itemInfoVer;
         ii.obj->setPosition(curX, curY);
         if (curIndex == newFirstIndex)
-            max += ii.size.y;
+            max += size.y;
 
-        curX += ii.size.x + _columnGap;
+        curX += size.x + _columnGap;
 
         if (curIndex % _curLineItemCount == _curLineItemCount - 1)
         {
             curX = 0;
-            curY += ii.size.y + _lineGap;
+            curY += size.y + _lineGap;
         }
         curIndex++;
     }
@@ -1603,33 +1957,79 @@ void GList::handleScroll1(bool forceUpdate)
         if (ii.updateFlag != _itemInfoVer && ii.obj != nullptr)
         {
             if (dynamic_cast<GButton*>(ii.obj))
-                ii.selected = ((GButton*)ii.obj)->isSelected();
+                setItemSelected(oldFirstIndex + i, ((GButton*)ii.obj)->isSelected());
             removeChildToPool(ii.obj);
             ii.obj = nullptr;
         }
     }
+    removeEmptyItemInfos();
 
-    if (deltaSize != 0 || firstItemDeltaSize != 0)
-        _scrollPane->changeContentSizeOnScrolling(0, deltaSize, 0, firstItemDeltaSize);
+    if (deltaSize != 0 || aboveViewDeltaSize != 0)
+        _scrollPane->changeContentSizeOnScrolling(0, deltaSize, 0, aboveViewDeltaSize);
+
+    if (itemSizeProvider != nullptr)
+        prefetchItemSizes(curIndex, UIConfig::virtualListPrefetchCount);
+
+    if (_renderPending)
+        scheduleOnce(SCHEDULE_SELECTOR(GList::renderPendingItems));
 
     if (curIndex > 0 && numChildren() > 0 && _container->getY() < 0 && getChildAt(0)->getY() > -_container->getY())
         handleScroll1(false);
 }
 
+void GList::renderPendingItems(float)
+{
+    if (_virtual && _renderPending)
+        handleScroll(false);
+}
+
+bool GList::checkRenderBudget()
+{
+    if (!isRenderBudgetExceeded())
+        return false;
+
+    //counted once per frame, not per deferred item
+    int frame = FGUIManager::GlobalManager().getFrameCount();
+    if (frame != _budgetOverrunFrame)
+    {
+        _budgetOverrunFrame = frame;
+        _budgetOverrunCount++;
+        FGUI_PROFILE_COUNT(LIST_BUDGET_OVERRUNS, 1);
+    }
+    return true;
+}
+
 void GList::handleScroll2(bool forceUpdate)
 {
+    FGUI_PROFILE_ZONE("GList::handleScroll2");
     _enterCounter++;
     if (_enterCounter > 3)
         return;
 
-    float pos = _scrollPane->getScrollingPosX();
-    float max = pos + _scrollPane->getViewSize().x;
-    bool end = pos == _scrollPane->getContentSize().x;
+    float viewPos = _scrollPane->getScrollingPosX();
+    float viewMax = viewPos + _scrollPane->getViewSize().x;
+    bool end = viewPos == _scrollPane->getContentSize().x;
+
+    //the columns ahead in the scrolling direction are rendered before they come into view
+    float pos = viewPos;
+    float max = viewMax;
+    if (UIConfig::virtualListOverscan > 0)
+    {
+        float speed = viewPos - _lastScrollPos;
+        float lead = MIN(MAX(UIConfig::virtualListOverscan, std::abs(speed) * OVERSCAN_FRAMES), _scrollPane->getViewSize().x);
+        if (speed < 0)
+            pos = MAX(pos - lead, 0);
+        else
+            max += lead;
+    }
+    _lastScrollPos = viewPos;
 
     int newFirstIndex = getIndexOnPos2(pos, forceUpdate);
-    if (newFirstIndex == _firstIndex && !forceUpdate)
+    if (newFirstIndex == _firstIndex && !forceUpdate && !_renderPending)
         return;
 
+    _renderPending = false;
+
     int oldFirstIndex = _firstIndex;
     _firstIndex = newFirstIndex;
     int curIndex = newFirstIndex;
@@ -1643,26 +2043,44 @@ void GList::handleScroll2(bool forceUpdate)
     float firstItemDeltaSize = 0;
     std::string url = _defaultItem;
     int partSize = (int)((_scrollPane->getViewSize().y - _lineGap * (_curLineItemCount - 1)) / _curLineItemCount);
+    double startTime = 0;
 
     _itemInfoVer++;
     while (curIndex < _realNumItems && (end || curX < max))
     {
         ItemInfo& ii = _virtualItems[curIndex];
 
-        if (ii.obj == nullptr || forceUpdate)
+        //out of budget: columns after the view wait for the next frames, the others take the
+        //placeholder if there is one
+        bool usePlaceholder = false;
+        if ((ii.obj == nullptr || ii.placeholder) && checkRenderBudget())
+        {
+            usePlaceholder = !UIConfig::virtualListPlaceholder.empty();
+            if (curX >= viewMax || usePlaceholder)
+                _renderPending = true;
+            if (curX >= viewMax)
+                break;
+        }
+
+        if (ii.obj == nullptr || forceUpdate || ii.placeholder)
         {
-            if (itemProvider != nullptr)
+            startTime = getMilliseconds();
+            if (usePlaceholder)
+                url = UIPackage::normalizeURL(UIConfig::virtualListPlaceholder);
+            else if (itemProvider != nullptr)
             {
                 url = itemProvider(curIndex % _numItems);
                 if (url.size() == 0)
                     url = _defaultItem;
                 url = UIPackage::normalizeURL(url);
             }
+            else
+                url = _defaultItem;
 
             if (ii.obj != nullptr && ii.obj->getResourceURL().compare(url) != 0)
             {
                 if (dynamic_cast<GButton*>(ii.obj))
-                    ii.selected = ((GButton*)ii.obj)->isSelected();
+                    setItemSelected(curIndex, ((GButton*)ii.obj)->isSelected());
                 removeChildToPool(ii.obj);
                 ii.obj = nullptr;
             }
@@ -1678,7 +2096,7 @@ void GList::handleScroll2(bool forceUpdate)
                     if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer && ii2.obj->getResourceURL().compare(url) == 0)
                     {
                         if (dynamic_cast<GButton*>(ii2.obj))
-                            ii2.selected = ((GButton*)ii2.obj)->isSelected();
+                            setItemSelected(j, ((GButton*)ii2.obj)->isSelected());
                         ii.obj = ii2.obj;
                         ii2.obj = nullptr;
                         if (j == reuseIndex)
@@ -1695,7 +2113,7 @@ void GList::handleScroll2(bool forceUpdate)
                     if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer && ii2.obj->getResourceURL().compare(url) == 0)
                     {
                         if (dynamic_cast<GButton*>(ii2.obj))
-                            ii2.selected = ((GButton*)ii2.obj)->isSelected();
+                            setItemSelected(j, ((GButton*)ii2.obj)->isSelected());
                         ii.obj = ii2.obj;
                         ii2.obj = nullptr;
                         if (j == reuseIndex)
@@ -1718,42 +2136,52 @@ void GList::handleScroll2(bool forceUpdate)
                     addChild(ii.obj);
             }
             if (dynamic_cast<GButton*>(ii.obj))
-                ((GButton*)ii.obj)->setSelected(ii.selected);
+                ((GButton*)ii.obj)->setSelected(isItemSelected(curIndex));
 
             needRender = true;
         }
         else
             needRender = forceUpdate;
+        ii.placeholder = usePlaceholder;
 
-        if (needRender)
+        if (needRender && ii.placeholder)
+        {
+            const hkvVec2& size = getItemSize(curIndex);
+            ii.obj->setSize(size.x, size.y);
+        }
+        else if (needRender)
         {
             if (_autoResizeItem && (_layout == ListLayoutType::SINGLE_ROW || _lineCount > 0))
                 ii.obj->setSize(ii.obj->getWidth(), partSize, true);
 
             itemRenderer(curIndex % _numItems, ii.obj);
+            chargeRenderBudget(startTime);
+            hkvVec2 newSize(ceil(ii.obj->getWidth()), ceil(ii.obj->getHeight()));
             if (curIndex % _curLineItemCount == 0)
             {
-                deltaSize += ceil(ii.obj->getWidth()) - ii.size.x;
-                if (curIndex == newFirstIndex && oldFirstIndex > newFirstIndex)
-                {
-                    firstItemDeltaSize = ceil(ii.obj->getWidth()) - ii.size.x;
-                }
+                //the copies of the item in a loop list take the new size too
+                float delta = newSize.x - getItemSize(curIndex).x;
+                deltaSize += delta * getItemCopyCount();
+                firstItemDeltaSize += delta * countCopiesBefore(curIndex, newFirstIndex);
+                //every column starting before the view pushes the visible ones right, the overscan columns included
+                if (oldFirstIndex > newFirstIndex && (curIndex == newFirstIndex || curX < viewPos))
+                    firstItemDeltaSize += delta;
             }
-            ii.size.x = ceil(ii.obj->getWidth());
-            ii.size.y = ceil(ii.obj->getHeight());
+            setItemSize(curIndex, newSize, 3);
         }
 
+        const hkvVec2& size = getItemSize(curIndex);
         ii.updateFlag = _itemInfoVer;
         ii.obj->setPosition(curX, curY);
         if (curIndex == newFirstIndex)
-            max += ii.size.x;
+            max += size.x;
 
-        curY += ii.size.y + _lineGap;
+        curY += size.y + _lineGap;
 
         if (curIndex % _curLineItemCount == _curLineItemCount - 1)
         {
             curY = 0;
-            curX += ii.size.x + _columnGap;
+            curX += size.x + _columnGap;
         }
         curIndex++;
     }
@@ -1764,42 +2192,65 @@ void GList::handleScroll2(bool forceUpdate)
         if (ii.updateFlag != _itemInfoVer && ii.obj != nullptr)
         {
             if (dynamic_cast<GButton*>(ii.obj))
-                ii.selected = ((GButton*)ii.obj)->isSelected();
+                setItemSelected(oldFirstIndex + i, ((GButton*)ii.obj)->isSelected());
             removeChildToPool(ii.obj);
             ii.obj = nullptr;
         }
     }
+    removeEmptyItemInfos();
 
     if (deltaSize != 0 || firstItemDeltaSize != 0)
         _scrollPane->changeContentSizeOnScrolling(deltaSize, 0, firstItemDeltaSize, 0);
 
+    if (_renderPending)
+        scheduleOnce(SCHEDULE_SELECTOR(GList::renderPendingItems));
+
     if (curIndex > 0 && numChildren() > 0 && _container->getX() < 0 && getChildAt(0)->getX() > -_container->getX())
         handleScroll2(false);
 }
 
 void GList::handleScroll3(bool forceUpdate)
 {
-    float pos = _scrollPane->getScrollingPosX();
+    FGUI_PROFILE_ZONE("GList::handleScroll3");
+    float viewPos = _scrollPane->getScrollingPosX();
+    float viewWidth = getViewWidth();
+    int pageSize = _curLineItemCount * _curLineItemCount2;
+
+    //the columns ahead in the scrolling direction are rendered before they come into view,
+    //the lead is turned into whole columns of the default item size
+    float pos = viewPos;
+    int overscanCols = 0;
+    if (UIConfig::virtualListOverscan > 0)
+    {
+        float speed = viewPos - _lastScrollPos;
+        float lead = MIN(MAX(UIConfig::virtualListOverscan, std::abs(speed) * OVERSCAN_FRAMES), viewWidth);
+        overscanCols = MIN((int)ceil(lead / MAX(_itemSize.x + _columnGap, 1.0f)), _curLineItemCount - 1);
+        if (speed < 0)
+            pos = MAX(pos - lead, 0);
+    }
+    _lastScrollPos = viewPos;
 
     int newFirstIndex = getIndexOnPos3(pos, forceUpdate);
-    if (newFirstIndex == _firstIndex && !forceUpdate)
+    if (newFirstIndex == _firstIndex && !forceUpdate && !_renderPending)
         return;
 
-    int oldFirstIndex = _firstIndex;
+    _renderPending = false;
     _firstIndex = newFirstIndex;
 
-    int reuseIndex = oldFirstIndex;
-    int virtualItemCount = (int)_virtualItems.size();
-    int pageSize = _curLineItemCount * _curLineItemCount2;
-    int startCol = newFirstIndex % _curLineItemCount;
-    float viewWidth = getViewWidth();
+    //columns are counted across the pages, the view shows the columns from viewCol to viewCol + _curLineItemCount
+    float pos2 = viewPos;
+    int viewFirstIndex = overscanCols > 0 ? getIndexOnPos3(pos2, false) : newFirstIndex;
+    int viewCol = viewFirstIndex / pageSize * _curLineItemCount + viewFirstIndex % _curLineItemCount;
+    int startCol = newFirstIndex / pageSize * _curLineItemCount + newFirstIndex % _curLineItemCount;
+    int endCol = startCol + _curLineItemCount + overscanCols;
     int page = (int)(newFirstIndex / pageSize);
     int startIndex = page * pageSize;
-    int lastIndex = startIndex + pageSize * 2;
+    int lastIndex = startIndex + pageSize * (overscanCols > 0 ? 3 : 2);
     bool needRender;
     std::string url = _defaultItem;
     int partWidth = (int)((_scrollPane->getViewSize().x - _columnGap * (_curLineItemCount - 1)) / _curLineItemCount);
     int partHeight = (int)((_scrollPane->getViewSize().y - _lineGap * (_curLineItemCount2 - 1)) / _curLineItemCount2);
+    double startTime = 0;
     _itemInfoVer++;
 
     for (int i = startIndex; i < lastIndex; i++)
@@ -1807,17 +2258,9 @@ void GList::handleScroll3(bool forceUpdate)
         if (i >= _realNumItems)
             continue;
 
-        int col = i % _curLineItemCount;
-        if (i - startIndex < pageSize)
-        {
-            if (col < startCol)
-                continue;
-        }
-        else
-        {
-            if (col > startCol)
-                continue;
-        }
+        int col = i / pageSize * _curLineItemCount + i % _curLineItemCount;
+        if (col < startCol || col > endCol)
+            continue;
 
         ItemInfo& ii = _virtualItems[i];
         ii.updateFlag = _itemInfoVer;
@@ -1834,20 +2277,47 @@ void GList::handleScroll3(bool forceUpdate)
         if (ii.updateFlag != _itemInfoVer)
             continue;
 
+        //out of budget: items out of the view wait for the next frames, the others take the
+        //placeholder if there is one
+        bool usePlaceholder = false;
+        if ((ii.obj == nullptr || ii.placeholder) && checkRenderBudget())
+        {
+            int col = i / pageSize * _curLineItemCount + i % _curLineItemCount;
+            bool inView = col >= viewCol && col <= viewCol + _curLineItemCount;
+            usePlaceholder = !UIConfig::virtualListPlaceholder.empty();
+            if (!inView || usePlaceholder)
+                _renderPending = true;
+            if (!inView)
+            {
+                if (ii.obj != nullptr)
+                {
+                    insertIndex = -1;
+                    lastObj = ii.obj;
+                }
+                continue;
+            }
+        }
+
+        startTime = getMilliseconds();
+        if (ii.obj != nullptr && ii.placeholder != usePlaceholder)
+        {
+            removeChildToPool(ii.obj);
+            ii.obj = nullptr;
+        }
+
         if (ii.obj == nullptr)
         {
-            while (reuseIndex < virtualItemCount)
+            for (auto &it : _virtualItems)
             {
-                ItemInfo& ii2 = _virtualItems[reuseIndex];
-                if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer)
+                ItemInfo& ii2 = it.second;
+                if (ii2.obj != nullptr && ii2.updateFlag != _itemInfoVer && ii2.placeholder == usePlaceholder)
                 {
                     if (dynamic_cast<GButton*>(ii2.obj))
-                        ii2.selected = ((GButton*)ii2.obj)->isSelected();
+                        setItemSelected(it.first, ((GButton*)ii2.obj)->isSelected());
                     ii.obj = ii2.obj;
                     ii2.obj = nullptr;
                     break;
                 }
-                reuseIndex++;
             }
 
             if (insertIndex == -1)
@@ -1855,13 +2325,17 @@ void GList::handleScroll3(bool forceUpdate)
 
             if (ii.obj == nullptr)
             {
-                if (itemProvider != nullptr)
+                if (usePlaceholder)
+                    url = UIPackage::normalizeURL(UIConfig::virtualListPlaceholder);
+                else if (itemProvider != nullptr)
                 {
                     url = itemProvider(i % _numItems);
                     if (url.size() == 0)
                         url = _defaultItem;
                     url = UIPackage::normalizeURL(url);
                 }
+                else
+                    url = _defaultItem;
 
                 ii.obj = _pool->getObject(url);
                 addChildAt(ii.obj, insertIndex);
@@ -1873,7 +2347,7 @@ void GList::handleScroll3(bool forceUpdate)
             insertIndex++;
 
             if (dynamic_cast<GButton*>(ii.obj))
-                ((GButton*)ii.obj)->setSelected(ii.selected);
+                ((GButton*)ii.obj)->setSelected(isItemSelected(i));
 
             needRender = true;
         }
@@ -1883,8 +2357,14 @@ void GList::handleScroll3(bool forceUpdate)
             insertIndex = -1;
             lastObj = ii.obj;
         }
+        ii.placeholder = usePlaceholder;
 
-        if (needRender)
+        if (needRender && ii.placeholder)
+        {
+            const hkvVec2& size = getItemSize(i);
+            ii.obj->setSize(size.x, size.y);
+        }
+        else if (needRender)
         {
             if (_autoResizeItem)
             {
@@ -1897,8 +2377,8 @@ void GList::handleScroll3(bool forceUpdate)
             }
 
             itemRenderer(i % _numItems, ii.obj);
-            ii.size.x = ceil(ii.obj->getWidth());
-            ii.size.y = ceil(ii.obj->getHeight());
+            chargeRenderBudget(startTime);
+            setItemSize(i, hkvVec2(ceil(ii.obj->getWidth()), ceil(ii.obj->getHeight())), 3);
         }
     }
 
@@ -1911,19 +2391,20 @@ void GList::handleScroll3(bool forceUpdate)
         if (i >= _realNumItems)
             continue;
 
-        ItemInfo& ii = _virtualItems[i];
-        if (ii.updateFlag == _itemInfoVer)
-            ii.obj->setPosition(xx, yy);
+        auto it = _virtualItems.find(i);
+        if (it != _virtualItems.end() && it->second.updateFlag == _itemInfoVer && it->second.obj != nullptr)
+            it->second.obj->setPosition(xx, yy);
 
-        if (ii.size.y > lineHeight)
-            lineHeight = ii.size.y;
+        const hkvVec2& size = getItemSize(i);
+        if (size.y > lineHeight)
+            lineHeight = size.y;
         if (i % _curLineItemCount == _curLineItemCount - 1)
         {
             xx = borderX;
             yy += lineHeight + _lineGap;
             lineHeight = 0;
 
-            if (i == startIndex + pageSize - 1)
+            if ((i - startIndex) % pageSize == pageSize - 1)
             {
                 borderX += viewWidth;
                 xx = borderX;
@@ -1931,20 +2412,24 @@ void GList::handleScroll3(bool forceUpdate)
             }
         }
         else
-            xx += ii.size.x + _columnGap;
+            xx += size.x + _columnGap;
     }
 
-    for (int i = reuseIndex; i < virtualItemCount; i++)
+    for (auto &it : _virtualItems)
     {
-        ItemInfo& ii = _virtualItems[i];
+        ItemInfo& ii = it.second;
         if (ii.updateFlag != _itemInfoVer && ii.obj != nullptr)
         {
             if (dynamic_cast<GButton*>(ii.obj))
-                ii.selected = ((GButton*)ii.obj)->isSelected();
+                setItemSelected(it.first, ((GButton*)ii.obj)->isSelected());
             removeChildToPool(ii.obj);
             ii.obj = nullptr;
         }
     }
+    removeEmptyItemInfos();
+
+    if (_renderPending)
+        scheduleOnce(SCHEDULE_SELECTOR(GList::renderPendingItems));
 }
 
 void GList::handleArchOrder1()
@@ -2482,8 +2967,10 @@ void GList::setup_BeforeAdd(TXMLElement * xml)
 
     TXMLElement* ix = xml->FirstChildElement("item");
     std::string url;
+    int entryIndex = -1;
     while (ix)
     {
+        entryIndex++;
         p = ix->Attribute("url");
         if (!p)
         {
@@ -2499,9 +2986,14 @@ void GList::setup_BeforeAdd(TXMLElement * xml)
         if (obj != nullptr)
         {
             addChild(obj);
+            _packageItems[obj] = entryIndex;
             p = ix->Attribute("title");
             if (p)
+            {
+                obj->_gearLocked = true;
                 obj->setText(p);
+                obj->_gearLocked = false;
+            }
             p = ix->Attribute("icon");
             if (p)
                 obj->setIcon(p);
@@ -2528,4 +3020,23 @@ void GList::setup_AfterAdd(TXMLElement * xml)
         _selectionController = _parent->getController(p);
 }
 
+void GList::applyStrings(const StringTable & strings)
+{
+    //entries without an item are skipped when the list is set up, and children added later
+    //have no string of their own
+    for (auto &it : _packageItems)
+    {
+        GObject* obj = it.first;
+        const char* p = obj->isRuntimeString(StringTable::TEXT) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::ITEM + it.second);
+        if (p)
+        {
+            obj->_gearLocked = true;
+            obj->setText(p);
+            obj->_gearLocked = false;
+        }
+    }
+
+    GComponent::applyStrings(strings);
+}
+
 NS_FGUI_END
\ No newline at end of file
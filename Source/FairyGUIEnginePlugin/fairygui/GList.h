@@ -3,6 +3,7 @@
 
 #include "FGUIMacros.h"
 #include "GComponent.h"
+#include "core/TextFormat.h"
 
 NS_FGUI_BEGIN
 
@@ -14,6 +15,21 @@ public:
     typedef std::function<void(int, GObject*)> ListItemRenderer;
     typedef std::function<std::string(int)> ListItemProvider;
 
+    struct ItemSizeRequest
+    {
+        std::string text;
+        TextFormat format;
+        float width;
+        float extraHeight;
+    };
+    typedef std::function<bool(int, ItemSizeRequest&)> ListItemSizeProvider;
+
+    struct ItemKey
+    {
+        std::string key;
+        uint32_t version;
+    };
+
     CREATE_FUNC(GList);
 
     const std::string& getDefaultItem() const { return _defaultItem; }
@@ -90,13 +106,31 @@ public:
     int getNumItems();
     void setNumItems(int value);
 
+    //Non virtual lists only. Children are matched to items by key and moved into place,
+    //itemRenderer is called only for new items and the ones whose version changed, so the
+    //rendered content must not depend on the item index.
+    void setItems(const std::vector<ItemKey>& items);
+
     int childIndexToItemIndex(int index);
     int itemIndexToChildIndex(int index);
 
+    //Measures the rows from startIndex with itemSizeProvider in the background. It is called
+    //automatically for the rows below the view, call it to start earlier, e.g. after setNumItems.
+    void prefetchItemSizes(int startIndex, int count);
+
+    //Virtual lists only. The frames in which the list deferred items because
+    //UIConfig::virtualListRenderBudget was used up.
+    int getBudgetOverrunCount() const { return _budgetOverrunCount; }
+
     virtual hkvVec2 getSnappingPosition(const hkvVec2& pt) override;
 
     ListItemRenderer itemRenderer;
     ListItemProvider itemProvider;
+    //Virtual single column lists only. Fills in the text which decides the height of a row,
+    //the row then takes the measured text height + extraHeight until it is rendered. This
+    //keeps the content size right before rows of different heights scroll into view.
+    //Return false to keep the default size for the row.
+    ListItemSizeProvider itemSizeProvider;
     bool scrollItemToViewOnClick;
     bool foldInvisibleItems;
 
@@ -111,6 +145,8 @@ protected:
     virtual void updateBounds() override;
     virtual void setup_BeforeAdd(TXMLElement* xml) override;
     virtual void setup_AfterAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
+    virtual bool hasLiveStrings() const override { return true; }
 
 private:
     void clearSelectionExcept(GObject *g);
@@ -125,11 +161,14 @@ private:
     void checkVirtualList();
     void setVirtualListChangedFlag(bool layoutChanged);
     void doRefreshVirtualList(float);
+    void renderPendingItems(float);
+    bool checkRenderBudget();
 
     void onScroll(EventContext *context);
 
     int getIndexOnPos1(float& pos, bool forceUpdate);
     int getIndexOnPos2(float& pos, bool forceUpdate);
+    int getLineOnPos(float& pos, bool vertical, float gap) const;
     int getIndexOnPos3(float& pos, bool forceUpdate);
 
     void handleScroll(bool forceUpdate);
@@ -142,6 +181,21 @@ private:
 
     void handleAlign(float contentWidth, float contentHeight);
 
+    void onItemSizeMeasured(int index, float height);
+    void applyItemSizeEstimates(float);
+
+    const hkvVec2& getItemSize(int index) const;
+    void setItemSize(int index, const hkvVec2& size, uint8_t state);
+    int nextSizedIndex(int index) const;
+    int getItemCopyCount() const { return _realNumItems / _numItems; }
+    int countCopiesBefore(int index, int endIndex) const;
+    float sumItemSizes(int startIndex, int endIndex, int step, bool vertical, float gap) const;
+    bool isItemSelected(int index) const { return _selectedItems[index % _numItems]; }
+    void setItemSelected(int index, bool value) { _selectedItems[index % _numItems] = value; }
+    GObject* findItemObject(int itemIndex) const;
+    void getVirtualSelection(std::vector<int>& result) const;
+    void removeEmptyItemInfos();
+
     ListLayoutType _layout;
     int _lineCount;
     int _columnCount;
@@ -171,17 +225,39 @@ private:
     bool _eventLocked;
     uint32_t _itemInfoVer;
     uint32_t _enterCounter;
+    float _estimatedSizeDelta;
+    float _estimatedPosDelta;
+    float _lastScrollPos;
+    bool _renderPending;
+    int _budgetOverrunCount;
+    int _budgetOverrunFrame;
 
     struct ItemInfo
     {
-        hkvVec2 size;
         GObject* obj;
         uint32_t updateFlag;
-        bool selected;
+        bool placeholder;
 
         ItemInfo();
     };
-    std::vector<ItemInfo> _virtualItems;
+    //only the items which have an object, by index
+    std::unordered_map<int, ItemInfo> _virtualItems;
+
+    struct ItemSize
+    {
+        hkvVec2 size;
+        uint8_t state; //1-measuring, 2-estimated, 3-rendered
+    };
+    //only the items whose size is not _itemSize or which are being measured, ordered by index
+    //so that positions are _itemSize times a count plus the records in between. By item index
+    //like _selectedItems, the copies of an item in a loop list are measured once.
+    std::map<int, ItemSize> _itemSizes;
+    //by item index, the copies of an item in a loop list share it
+    std::vector<bool> _selectedItems;
+    //what each child was last rendered from by setItems
+    std::unordered_map<GObject*, ItemKey> _itemKeys;
+    //the index of the <item> entry each child created from the package was made from
+    std::unordered_map<GObject*, int> _packageItems;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(GList);
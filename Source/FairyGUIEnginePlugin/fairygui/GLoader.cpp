@@ -1,5 +1,7 @@
 #include "GLoader.h"
 #include "UIPackage.h"
+#include "FGUIManager.h"
+#include "core/TextureCache.h"
 #include "utils/ToolSet.h"
 
 NS_FGUI_BEGIN
@@ -12,12 +14,14 @@ GLoader::GLoader() :
     _updatingLayout(false),
     _contentItem(nullptr),
     _contentStatus(0),
+    _externalLoadHandle(0),
     _content(nullptr)
 {
 }
 
 GLoader::~GLoader()
 {
+    cancelExternalLoad();
     CC_SAFE_RELEASE(_content);
 }
 
@@ -152,21 +156,40 @@ void GLoader::loadFromPackage()
 
 void GLoader::loadExternal()
 {
-    VTextureObject* tex = Vision::TextureManager.Load2DTexture(_url.c_str(), VTM_FLAG_DEFAULT_NON_MIPMAPPED);
-    if (tex)
-        onExternalLoadSuccess(tex);
-    else
-        onExternalLoadFailed();
+    _externalLoadHandle = FGUIManager::GlobalManager().getTextureCache()->load(_url, [this](NTexture* texture)
+    {
+        _externalLoadHandle = 0;
+        if (texture)
+            onExternalLoadSuccess(texture);
+        else
+            onExternalLoadFailed();
+    });
+}
+
+void GLoader::cancelExternalLoad()
+{
+    if (_externalLoadHandle != 0)
+    {
+        TextureCache* cache = FGUIManager::GlobalManager().getTextureCache();
+        if (cache)
+            cache->cancel(_externalLoadHandle);
+        _externalLoadHandle = 0;
+    }
 }
 
 void GLoader::onExternalLoadSuccess(VTextureObject* texture)
 {
-    _contentStatus = 4;
     NTexture* ntex = new NTexture(texture);
-    _content->setTexture(ntex);
+    onExternalLoadSuccess(ntex);
     ntex->release();
-    _contentSourceSize.x = texture->GetTextureWidth();
-    _contentSourceSize.y = texture->GetTextureHeight();
+}
+
+void GLoader::onExternalLoadSuccess(NTexture* texture)
+{
+    _contentStatus = 4;
+    _content->setTexture(texture);
+    _contentSourceSize.x = texture->getWidth();
+    _contentSourceSize.y = texture->getHeight();
     updateLayout();
 }
 
@@ -177,6 +200,7 @@ void GLoader::onExternalLoadFailed()
 
 void GLoader::clearContent()
 {
+    cancelExternalLoad();
     clearErrorState();
 
     _content->clear();
@@ -53,6 +53,7 @@ protected:
 
     virtual void loadExternal();
     void onExternalLoadSuccess(VTextureObject* texture);
+    void onExternalLoadSuccess(NTexture* texture);
     void onExternalLoadFailed();
 
 private:
@@ -62,6 +63,7 @@ private:
     void updateLayout();
     void setErrorState();
     void clearErrorState();
+    void cancelExternalLoad();
 
     std::string _url;
     AlignType _align;
@@ -73,6 +75,7 @@ private:
     hkvVec2 _contentSize;
     hkvVec2 _contentSourceSize;
     int _contentStatus;
+    int _externalLoadHandle;
 
     MovieClip* _content;
 
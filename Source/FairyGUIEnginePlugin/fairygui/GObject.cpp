@@ -4,6 +4,7 @@
 #include "GRoot.h"
 #include "UIPackage.h"
 #include "UIConfig.h"
+#include "utils/Profiler.h"
 #include "gears/GearXY.h"
 #include "gears/GearSize.h"
 #include "gears/GearColor.h"
@@ -13,6 +14,7 @@
 #include "gears/GearIcon.h"
 #include "gears/GearDisplay.h"
 #include "utils/ToolSet.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -32,6 +34,7 @@ GObject::GObject() :
     maxSize(0, 0),
     initSize(0, 0),
     _sizePercentInGroup(0.0f),
+    _boundsIndex(-1),
     _pivot(0, 0),
     _pivotAsAnchor(false),
     _alpha(1.0f),
@@ -41,6 +44,8 @@ GObject::GObject() :
     _handlingController(false),
     _touchable(true),
     _grayed(false),
+    _stringsComponent(0),
+    _stringsElement(0),
     _draggable(false),
     _dragBounds(nullptr),
     _sortingOrder(0),
@@ -53,8 +58,12 @@ GObject::GObject() :
     _underConstruct(false),
     _gearLocked(false),
     _packageItem(nullptr),
-    _data(nullptr)
+    _data(nullptr),
+    _stringsIndex(-1),
+    _runtimeStrings(0)
 {
+    FGUI_PROFILE_COUNT(OBJECTS_CREATED, 1);
+
     std::stringstream ss;
     ss << _intID;
     id = ss.str();
@@ -66,6 +75,9 @@ GObject::GObject() :
 
 GObject::~GObject()
 {
+    if (_stringsIndex != -1)
+        UIPackage::removeTranslatedObject(this);
+
     removeFromParent();
 
     if (_displayObject)
@@ -115,7 +127,7 @@ void GObject::setPosition(float xv, float yv)
 
         if (_parent != nullptr && dynamic_cast<GList*>(_parent) == nullptr)
         {
-            _parent->setBoundsChangedFlag();
+            _parent->childBoundsChanged(this);
             if (_group != nullptr)
                 _group->setBoundsChangedFlag();
 
@@ -208,7 +220,7 @@ void GObject::setSize(float wv, float hv, bool ignorePivot /*= false*/)
         if (_parent != nullptr)
         {
             _relations->onOwnerSizeChanged(dWidth, dHeight, _pivotAsAnchor || !ignorePivot);
-            _parent->setBoundsChangedFlag();
+            _parent->childBoundsChanged(this);
             if (_group != nullptr)
                 _group->setBoundsChangedFlag(true);
         }
@@ -324,7 +336,7 @@ void GObject::setVisible(bool value)
         _visible = value;
         handleVisibleChanged();
         if (_parent != nullptr)
-            _parent->setBoundsChangedFlag();
+            _parent->childBoundsChanged(this);
     }
 }
 
@@ -399,6 +411,7 @@ void GObject::setIcon(const std::string & text)
 void GObject::setTooltips(const std::string & value)
 {
     _tooltips = value;
+    setRuntimeString(StringTable::TIPS);
     if (!_tooltips.empty())
     {
         addListener(UIEventType::RollOver, CALLBACK_1(GObject::onRollOver, this), EventTag(this));
@@ -635,6 +648,25 @@ void GObject::constructFromResource()
 {
 }
 
+void GObject::collectMemoryStats(MemoryStats & stats) const
+{
+    stats.addObject();
+    stats.add(MemoryStats::OBJECTS, sizeof(GObject) + MemoryStats::stringBytes(id)
+        + MemoryStats::stringBytes(name) + MemoryStats::stringBytes(_tooltips));
+    stats.add(MemoryStats::EVENT_LISTENERS, getListenerMemoryUsage());
+
+    if (_displayObject != nullptr)
+        _displayObject->collectMemoryStats(stats);
+
+    size_t bytes = _relations->getMemoryUsage();
+    for (int i = 0; i < 8; i++)
+    {
+        if (_gears[i] != nullptr)
+            bytes += _gears[i]->getMemoryUsage();
+    }
+    stats.add(MemoryStats::GEARS_RELATIONS, bytes);
+}
+
 void GObject::handleInit()
 {
 }
@@ -820,6 +852,57 @@ void GObject::setup_AfterAdd(TXMLElement * xml)
     }
 }
 
+void GObject::setupStrings(int componentId, int elementId)
+{
+    _stringsComponent = componentId;
+    _stringsElement = elementId;
+    if (elementId == 0)
+        return;
+
+    const StringTable& strings = UIPackage::getStrings();
+    if (!strings.isEmpty())
+    {
+        _gearLocked = true;
+        applyStrings(strings);
+        _gearLocked = false;
+    }
+
+    if (_stringsIndex == -1 && hasLiveStrings())
+        UIPackage::addTranslatedObject(this);
+}
+
+void GObject::applyStrings(const StringTable & strings)
+{
+    const char* p;
+
+    if (!_tooltips.empty() && !isRuntimeString(StringTable::TIPS))
+    {
+        p = strings.find(_stringsComponent, _stringsElement, StringTable::TIPS);
+        if (p)
+            setTooltips(p);
+    }
+
+    if (_gears[6] != nullptr)
+    {
+        //the pages are translated either way, the text shown now only if the package set it
+        GearText* gear = (GearText*)_gears[6];
+        gear->applyStrings(strings, _stringsComponent, _stringsElement);
+        if (gear->getController() != nullptr && !isRuntimeString(StringTable::TEXT))
+            gear->apply();
+    }
+}
+
+void GObject::setRuntimeString(int slot, bool force)
+{
+    if (force || (!_underConstruct && !_gearLocked))
+        _runtimeStrings |= 1 << slot;
+}
+
+bool GObject::hasLiveStrings() const
+{
+    return _gears[6] != nullptr || !_tooltips.empty();
+}
+
 void GObject::initDrag()
 {
     if (_draggable)
@@ -13,6 +13,8 @@ class GRoot;
 class GController;
 class GearBase;
 class PackageItem;
+class MemoryStats;
+class StringTable;
 
 class FGUI_IMPEXP GObject : public Node
 {
@@ -136,6 +138,7 @@ public:
     void removeClickListener(const EventTag& tag) { removeListener(UIEventType::Click, tag); }
 
     virtual void constructFromResource();
+    virtual void collectMemoryStats(MemoryStats& stats) const;
 
     template<typename T> T* as();
 
@@ -172,6 +175,15 @@ protected:
     virtual void setup_BeforeAdd(TXMLElement* xml);
     virtual void setup_AfterAdd(TXMLElement* xml);
 
+    //translates the object with the strings of the element it was created from, see UIPackage::setStringsSource
+    void setupStrings(int componentId, int elementId);
+    virtual void applyStrings(const StringTable& strings);
+    virtual bool hasLiveStrings() const;
+    //a string the game sets itself is kept when the language changes; writes while constructing,
+    //from gears or while strings are applied are the package's and do not count
+    void setRuntimeString(int slot, bool force = false);
+    bool isRuntimeString(int slot) const { return (_runtimeStrings & (1 << slot)) != 0; }
+
     bool init();
 
     void updateGear(int index);
@@ -190,6 +202,8 @@ protected:
     bool _visible;
     bool _touchable;
     bool _grayed;
+    int _stringsComponent;
+    int _stringsElement;
 
 private:
     bool internalVisible() const;
@@ -214,12 +228,15 @@ private:
     bool _pixelSnapping;
     GGroup* _group;
     float _sizePercentInGroup;
+    int _boundsIndex;
     Relations* _relations;
     GearBase* _gears[8];
     void * _data;
     Value _customData;
     hkvVec2 _dragTouchStartPos;
     VRectanglef* _dragBounds;
+    int _stringsIndex;
+    unsigned char _runtimeStrings;
 
     static GObject* _draggingObject;
 
@@ -227,6 +244,9 @@ private:
     friend class GGroup;
     friend class RelationItem;
     friend class UIObjectFactory;
+    friend class UIPackage;
+    friend class GLabel;
+    friend class GList;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(GObject);
@@ -1,4 +1,5 @@
 #include "GTextField.h"
+#include "StringTable.h"
 #include "utils/ToolSet.h"
 #include "utils/UBBParser.h"
 
@@ -46,6 +47,7 @@ const std::string & GTextField::getText() const
 void GTextField::setText(const std::string & value)
 {
     _text = value;
+    setRuntimeString(StringTable::TEXT);
     setTextFieldText();
     updateSize();
     updateGear(6);
@@ -246,4 +248,13 @@ void GTextField::setup_AfterAdd(TXMLElement * xml)
         setText(p);
 }
 
+void GTextField::applyStrings(const StringTable & strings)
+{
+    const char* p = isRuntimeString(StringTable::TEXT) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::TEXT);
+    if (p)
+        setText(p);
+
+    GObject::applyStrings(strings);
+}
+
 NS_FGUI_END
@@ -48,6 +48,8 @@ protected:
     virtual void handleSizeChanged() override;
     virtual void setup_BeforeAdd(TXMLElement* xml) override;
     virtual void setup_AfterAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
+    virtual bool hasLiveStrings() const override { return true; }
 
     void initStyle();
     virtual void getTextFieldText();
@@ -27,6 +27,7 @@ void GTextInput::handleInit()
 void GTextInput::setPrompt(const std::string & value)
 {
     _inputTextField->setPromptText(value);
+    setRuntimeString(StringTable::PROMPT);
 }
 
 void GTextInput::setPassword(bool value)
@@ -50,7 +51,13 @@ void GTextInput::setRestrict(const std::string & value)
 
 void GTextInput::getTextFieldText()
 {
-    _text = _inputTextField->getText();
+    //text typed in is the user's, it is never replaced by a translation
+    const std::string& text = _inputTextField->getText();
+    if (text != _text)
+    {
+        _text = text;
+        setRuntimeString(StringTable::TEXT, true);
+    }
 }
 
 void GTextInput::setTextFieldText()
@@ -84,4 +91,14 @@ void GTextInput::setup_BeforeAdd(TXMLElement * xml)
         setKeyboardType(atoi(p));
 }
 
+void GTextInput::applyStrings(const StringTable & strings)
+{
+    const char* p = isRuntimeString(StringTable::PROMPT) ? nullptr : strings.find(_stringsComponent, _stringsElement, StringTable::PROMPT);
+    if (p)
+        setPrompt(p);
+
+    getTextFieldText();
+    GTextField::applyStrings(strings);
+}
+
 NS_FGUI_END
\ No newline at end of file
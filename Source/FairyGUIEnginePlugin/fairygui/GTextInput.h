@@ -27,6 +27,7 @@ protected:
     virtual void getTextFieldText() override;
     virtual void setTextFieldText() override;
     virtual void setup_BeforeAdd(TXMLElement* xml) override;
+    virtual void applyStrings(const StringTable& strings) override;
 
 private:
     InputTextField* _inputTextField;
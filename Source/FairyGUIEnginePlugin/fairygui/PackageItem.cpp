@@ -15,8 +15,10 @@ PackageItem::PackageItem() :
     scaleByTile(false),
     tileGridIndice(0),
     repeatDelay(0),
+    frames(nullptr),
     componentData(nullptr),
     displayList(nullptr),
+    stringsId(0),
     extensionCreator(nullptr),
     bitmapFont(nullptr)
 {
@@ -26,6 +28,7 @@ PackageItem::~PackageItem()
 {
     CC_SAFE_DELETE(scale9Grid);
     CC_SAFE_RELEASE(texture);
+    CC_SAFE_RELEASE(frames);
     if (displayList)
     {
         for (auto &it : *displayList)
@@ -47,7 +50,8 @@ DisplayListItem::DisplayListItem(PackageItem* pi, const std::string& type)
     :packageItem(pi),
     type(type),
     desc(nullptr),
-    listItemCount(0)
+    listItemCount(0),
+    stringsId(0)
 {
 }
 
@@ -5,6 +5,7 @@
 #include "core/MovieClip.h"
 #include "core/NTexture.h"
 #include "core/BitmapFont.h"
+#include "Transition.h"
 
 NS_FGUI_BEGIN
 
@@ -45,11 +46,13 @@ public:
     float interval;
     float repeatDelay;
     bool swing;
-    hkvArray<MovieClip::Frame> frames;
+    MovieClip::Frames* frames;
 
     //component
     TXMLDocument* componentData;
     std::vector<DisplayListItem*>* displayList;
+    Vector<TransitionData*> transitions;
+    int stringsId;
     std::function<GComponent*()> extensionCreator;
 
     //sound
@@ -66,6 +69,7 @@ public:
     std::string type;
     TXMLElement* desc;
     int listItemCount;
+    int stringsId;
 
     DisplayListItem(PackageItem* pi, const std::string& type);
     virtual ~DisplayListItem();
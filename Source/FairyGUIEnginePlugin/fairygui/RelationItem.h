@@ -3,6 +3,7 @@
 
 #include "FGUIMacros.h"
 #include "core/DisplayObject.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
@@ -61,6 +62,8 @@ public:
 class RelationItem
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     RelationItem(GObject* owner);
     ~RelationItem();
 
@@ -86,6 +89,8 @@ private:
     WeakPtr _target;
     std::vector<RelationDef> _defs;
     hkvVec4 _targetData;
+
+    friend class Relations;
 };
 
 NS_FGUI_END
@@ -295,6 +295,14 @@ bool Relations::isEmpty() const
     return _items.size() == 0;
 }
 
+size_t Relations::getMemoryUsage() const
+{
+    size_t bytes = sizeof(Relations) + _items.capacity() * sizeof(RelationItem*);
+    for (auto &it : _items)
+        bytes += sizeof(RelationItem) + it->_defs.capacity() * sizeof(RelationDef);
+    return bytes;
+}
+
 void Relations::setup(TXMLElement * xml)
 {
     TXMLElement* cxml = xml->FirstChildElement("relation");
@@ -11,6 +11,8 @@ class GObject;
 class FGUI_IMPEXP Relations
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     Relations(GObject* owner);
     ~Relations();
 
@@ -24,6 +26,7 @@ public:
     void copyFrom(const Relations& source);
     void onOwnerSizeChanged(float dWidth, float dHeight, bool applyPivot);
     bool isEmpty() const;
+    size_t getMemoryUsage() const;
     void setup(TXMLElement* xml);
 
     GObject* handling;
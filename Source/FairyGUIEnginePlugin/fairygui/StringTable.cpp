@@ -0,0 +1,321 @@
+#include "StringTable.h"
+
+#include <algorithm>
+
+NS_FGUI_BEGIN
+
+static const char MAGIC[4] = { 'F', 'G', 'S', 'T' };
+static const int VERSION = 1;
+
+std::unordered_map<std::string, int> StringTable::_ids;
+std::vector<std::string> StringTable::_names;
+
+template<typename T>
+static void writeValue(std::vector<char>& buffer, T value)
+{
+    //the format is little endian, like every target of the engine
+    const char* p = (const char*)&value;
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+template<typename T>
+static T readValue(const char*& p)
+{
+    T value;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+static int parseSlot(const char* str)
+{
+    if (strcmp(str, "tips") == 0)
+        return StringTable::TIPS;
+    else if (strcmp(str, "texts") == 0)
+        return StringTable::TEXTS;
+    else if (strcmp(str, "texts_def") == 0)
+        return StringTable::TEXTS_DEF;
+    else if (strcmp(str, "prompt") == 0)
+        return StringTable::PROMPT;
+    else if (*str >= '0' && *str <= '9')
+        return StringTable::ITEM + atoi(str);
+    else
+        return -1;
+}
+
+StringTable::StringTable()
+{
+}
+
+bool StringTable::parse(const char * xmlString, size_t nBytes)
+{
+    TXMLDocument* xml = new TXMLDocument();
+    xml->Parse(xmlString, nBytes);
+
+    TXMLElement* root = xml->RootElement();
+    if (root == nullptr)
+    {
+        CCLOGWARN("FairyGUI: invalid strings source");
+        delete xml;
+        return false;
+    }
+
+    //built aside, a source that cannot be read leaves the current strings in place
+    StringTable table;
+    std::string componentName, elementName;
+    TXMLElement* ele = root->FirstChildElement("string");
+    while (ele)
+    {
+        //names are <package id><item id>-<element id>[-<slot>]
+        const char* name = ele->Attribute("name");
+        const char* p = name ? strchr(name, '-') : nullptr;
+        if (p != nullptr)
+        {
+            componentName.assign(name, p - name);
+
+            int slot;
+            const char* p2 = strchr(p + 1, '-');
+            if (p2 != nullptr)
+            {
+                elementName.assign(p + 1, p2 - p - 1);
+                slot = parseSlot(p2 + 1);
+            }
+            else
+            {
+                elementName.assign(p + 1);
+                slot = TEXT;
+            }
+
+            const char* text = ele->GetText();
+            if (slot != -1)
+                table.add(intern(componentName), intern(elementName), slot, text ? text : "", text ? strlen(text) : 0);
+        }
+
+        ele = ele->NextSiblingElement("string");
+    }
+
+    delete xml;
+
+    table.sort();
+    swap(table);
+    return true;
+}
+
+bool StringTable::load(const std::string & filePath)
+{
+    IVFileInStream* stream = VFileAccessManager::GetInstance()->Open(filePath.c_str());
+    if (stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot open string table '%s'", filePath.c_str());
+        return false;
+    }
+
+    std::vector<char> data(stream->GetSize());
+    size_t len = data.empty() ? 0 : stream->Read(data.data(), data.size());
+    stream->Close();
+
+    const char* p = data.data();
+    const char* end = p + len;
+    if (len < 12 || memcmp(p, MAGIC, 4) != 0)
+    {
+        CCLOGWARN("FairyGUI: '%s' is not a string table", filePath.c_str());
+        return false;
+    }
+    p += 4;
+    if (readValue<int>(p) != VERSION)
+    {
+        CCLOGWARN("FairyGUI: unsupported string table version in '%s'", filePath.c_str());
+        return false;
+    }
+
+    //the file has its own name indices, they are mapped to the ids of this run
+    int cnt = readValue<int>(p);
+    std::vector<int> ids;
+    ids.reserve(cnt > 0 ? cnt : 0);
+    for (int i = 0; i < cnt; i++)
+    {
+        if (end - p < 4)
+            break;
+        int nameLen = readValue<int>(p);
+        if (nameLen < 0 || end - p < nameLen)
+            break;
+        ids.push_back(intern(std::string(p, nameLen)));
+        p += nameLen;
+    }
+
+    if ((int)ids.size() != cnt || end - p < 4)
+    {
+        CCLOGWARN("FairyGUI: string table '%s' is truncated", filePath.c_str());
+        return false;
+    }
+
+    cnt = readValue<int>(p);
+    if (cnt < 0 || (size_t)(end - p) < (size_t)cnt * 16 + 4)
+    {
+        CCLOGWARN("FairyGUI: string table '%s' is truncated", filePath.c_str());
+        return false;
+    }
+
+    //built aside, a file that cannot be read leaves the current strings in place
+    StringTable table;
+    table._entries.reserve(cnt);
+    for (int i = 0; i < cnt; i++)
+    {
+        int component = readValue<int>(p);
+        int element = readValue<int>(p);
+        int slot = readValue<int>(p);
+        Entry entry;
+        entry.offset = readValue<int>(p);
+        if (component < 0 || component >= (int)ids.size() || element < 0 || element >= (int)ids.size())
+            continue;
+
+        entry.key = makeKey(ids[component], ids[element], slot);
+        table._entries.push_back(entry);
+    }
+
+    int poolSize = readValue<int>(p);
+    if (poolSize < 0 || end - p < poolSize)
+    {
+        CCLOGWARN("FairyGUI: string table '%s' is truncated", filePath.c_str());
+        return false;
+    }
+    table._pool.assign(p, p + poolSize);
+    if (!table._pool.empty())
+        table._pool.back() = 0;
+
+    //entries pointing outside the pool are dropped
+    table._entries.erase(std::remove_if(table._entries.begin(), table._entries.end(),
+        [poolSize](const Entry& entry) { return entry.offset < 0 || entry.offset >= poolSize; }), table._entries.end());
+
+    table.sort();
+    swap(table);
+    return true;
+}
+
+bool StringTable::save(const std::string & filePath) const
+{
+    IVFileOutStream* stream = VFileAccessManager::GetInstance()->Create(filePath.c_str());
+    if (stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot write string table to '%s'", filePath.c_str());
+        return false;
+    }
+
+    std::unordered_map<int, int> indices;
+    std::vector<int> usedIds;
+    std::vector<int> records;
+    records.reserve(_entries.size() * 4);
+    for (auto &it : _entries)
+    {
+        int ids[2] = { (int)(it.key >> 40), (int)((it.key >> 16) & 0xFFFFFF) };
+        for (int i = 0; i < 2; i++)
+        {
+            auto it2 = indices.find(ids[i]);
+            if (it2 == indices.end())
+            {
+                it2 = indices.insert(std::make_pair(ids[i], (int)usedIds.size())).first;
+                usedIds.push_back(ids[i]);
+            }
+            records.push_back(it2->second);
+        }
+        records.push_back((int)(it.key & 0xFFFF));
+        records.push_back(it.offset);
+    }
+
+    std::vector<char> buffer;
+    buffer.insert(buffer.end(), MAGIC, MAGIC + 4);
+    writeValue<int>(buffer, VERSION);
+    writeValue<int>(buffer, (int)usedIds.size());
+    for (auto &it : usedIds)
+    {
+        const std::string& name = _names[it - 1];
+        writeValue<int>(buffer, (int)name.size());
+        buffer.insert(buffer.end(), name.begin(), name.end());
+    }
+    writeValue<int>(buffer, (int)_entries.size());
+    for (auto &it : records)
+        writeValue<int>(buffer, it);
+    writeValue<int>(buffer, (int)_pool.size());
+    buffer.insert(buffer.end(), _pool.begin(), _pool.end());
+
+    stream->Write(buffer.data(), buffer.size());
+    stream->Close();
+    return true;
+}
+
+void StringTable::clear()
+{
+    _entries.clear();
+    _pool.clear();
+}
+
+void StringTable::swap(StringTable & other)
+{
+    _entries.swap(other._entries);
+    _pool.swap(other._pool);
+}
+
+const char * StringTable::find(int componentId, int elementId, int slot) const
+{
+    if (_entries.empty())
+        return nullptr;
+
+    Entry key;
+    key.key = makeKey(componentId, elementId, slot);
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), key);
+    if (it == _entries.end() || it->key != key.key)
+        return nullptr;
+
+    return &_pool[it->offset];
+}
+
+int StringTable::intern(const char * name)
+{
+    if (name == nullptr || *name == 0)
+        return 0;
+
+    auto it = _ids.find(name);
+    if (it != _ids.end())
+        return it->second;
+
+    _names.push_back(name);
+    int id = (int)_names.size();
+    _ids[name] = id;
+    return id;
+}
+
+hkUint64 StringTable::makeKey(int componentId, int elementId, int slot)
+{
+    //24 bits for each id, 16 for the slot
+    return ((hkUint64)componentId << 40) | ((hkUint64)(elementId & 0xFFFFFF) << 16) | (hkUint64)(slot & 0xFFFF);
+}
+
+void StringTable::add(int componentId, int elementId, int slot, const char * text, size_t len)
+{
+    Entry entry;
+    entry.key = makeKey(componentId, elementId, slot);
+    entry.offset = (int)_pool.size();
+    _entries.push_back(entry);
+
+    _pool.insert(_pool.end(), text, text + len);
+    _pool.push_back(0);
+}
+
+void StringTable::sort()
+{
+    //a later string with the same name wins, as it did when the XML was read into a map
+    std::stable_sort(_entries.begin(), _entries.end());
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        auto next = it + 1;
+        while (next != _entries.end() && next->key == it->key)
+            ++next;
+        if (next - it > 1)
+            *it = *(next - 1);
+        it = next;
+    }
+    _entries.erase(std::unique(_entries.begin(), _entries.end(),
+        [](const Entry& a, const Entry& b) { return a.key == b.key; }), _entries.end());
+}
+
+NS_FGUI_END
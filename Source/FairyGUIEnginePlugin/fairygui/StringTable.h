@@ -0,0 +1,64 @@
+#ifndef __STRINGTABLE_H__
+#define __STRINGTABLE_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+//Translated strings, keyed by (component, element, slot). Component and element names are
+//interned to ids once when a package is loaded, so looking a string up while objects are
+//created is a binary search on integers. The table can be built from the strings XML of
+//the editor, or saved to and loaded from a compiled binary file that needs no XML parsing.
+class FGUI_IMPEXP StringTable
+{
+public:
+    enum Slot
+    {
+        TEXT,
+        TIPS,
+        PROMPT,
+        TEXTS,
+        TEXTS_DEF,
+        ITEM    //ITEM + n for list and combo box item n, ITEM + 0 is also the selected title of a button
+    };
+
+    StringTable();
+
+    bool parse(const char* xmlString, size_t nBytes);
+    bool load(const std::string& filePath);
+    bool save(const std::string& filePath) const;
+    void clear();
+    void swap(StringTable& other);
+
+    //returns nullptr when the table has no string for the key
+    const char* find(int componentId, int elementId, int slot) const;
+    bool isEmpty() const { return _entries.empty(); }
+    int getCount() const { return (int)_entries.size(); }
+
+    //ids start at 1 and are shared by every table, 0 is returned for an empty name
+    static int intern(const char* name);
+    static int intern(const std::string& name) { return intern(name.c_str()); }
+
+private:
+    struct Entry
+    {
+        hkUint64 key;
+        int offset;
+
+        bool operator<(const Entry& other) const { return key < other.key; }
+    };
+
+    static hkUint64 makeKey(int componentId, int elementId, int slot);
+    void add(int componentId, int elementId, int slot, const char* text, size_t len);
+    void sort();
+
+    std::vector<Entry> _entries;
+    std::vector<char> _pool;
+
+    static std::unordered_map<std::string, int> _ids;
+    static std::vector<std::string> _names;
+};
+
+NS_FGUI_END
+
+#endif
@@ -5,6 +5,8 @@
 #include "gears/GearAnimation.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/Profiler.h"
+#include "utils/MemoryStats.h"
 #include "third_party/cc/ccRandom.h"
 
 NS_FGUI_BEGIN
@@ -31,7 +33,7 @@ public:
     bool b2;
 
     TransitionValue();
-    TransitionValue(TransitionValue& source);
+    TransitionValue(const TransitionValue& source);
     TransitionValue& operator= (const TransitionValue& other);
 };
 
@@ -40,7 +42,7 @@ TransitionValue::TransitionValue() :
 {
 }
 
-TransitionValue::TransitionValue(TransitionValue& other)
+TransitionValue::TransitionValue(const TransitionValue& other)
 {
     *this = other;
 }
@@ -60,9 +62,11 @@ TransitionValue& TransitionValue::operator= (const TransitionValue& other)
     return *this;
 }
 
-class TransitionItem
+class TransitionItemData
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     float time;
     std::string targetId;
     TransitionActionType type;
@@ -77,6 +81,34 @@ public:
     std::string label;
     std::string label2;
 
+    TransitionItemData();
+};
+
+TransitionItemData::TransitionItemData() :
+    time(0),
+    type(TransitionActionType::XY),
+    duration(0),
+    easeType(tweenfunc::TweenType::Quad_EaseOut),
+    repeat(0),
+    yoyo(false),
+    tween(false)
+{
+}
+
+class TransitionItem
+{
+public:
+    FGUI_SLAB_ALLOCATED
+
+    const TransitionItemData* data;
+
+    //copied from data, changed by setTarget/setDuration/setValue and during playing
+    std::string targetId;
+    float duration;
+    TransitionValue value;
+    TransitionValue startValue;
+    TransitionValue endValue;
+
     //hooks
     Transition::TransitionHook hook;
     Transition::TransitionHook hook2;
@@ -87,17 +119,16 @@ public:
     bool filterCreated;
     uint32_t displayLockToken;
 
-    TransitionItem();
+    TransitionItem(const TransitionItemData* data);
 };
 
-TransitionItem::TransitionItem() :
-    time(0),
-    type(TransitionActionType::XY),
-    duration(0),
-    easeType(tweenfunc::TweenType::Quad_EaseOut),
-    repeat(0),
-    yoyo(false),
-    tween(false),
+TransitionItem::TransitionItem(const TransitionItemData* data) :
+    data(data),
+    targetId(data->targetId),
+    duration(data->duration),
+    value(data->value),
+    startValue(data->startValue),
+    endValue(data->endValue),
     hook(nullptr),
     hook2(nullptr),
     completed(false),
@@ -105,13 +136,13 @@ TransitionItem::TransitionItem() :
     filterCreated(false),
     displayLockToken(0)
 {
-
 }
 
 Transition::Transition(GComponent* owner, int index) :
     autoPlayRepeat(1),
     autoPlayDelay(0),
     _owner(owner),
+    _data(nullptr),
     _totalTimes(0),
     _totalTasks(0),
     _playing(false),
@@ -130,6 +161,32 @@ Transition::~Transition()
 {
     for (auto &item : _items)
         delete item;
+    CC_SAFE_RELEASE(_data);
+}
+
+void Transition::setup(TransitionData* data)
+{
+    _data = data;
+    _data->retain();
+
+    name = data->name;
+    _options = data->options;
+    _autoPlay = data->autoPlay;
+    autoPlayRepeat = data->autoPlayRepeat;
+    autoPlayDelay = data->autoPlayDelay;
+    _maxTime = data->maxTime;
+}
+
+void Transition::ensureItems()
+{
+    //the items are copied from the shared data on first use, an instance whose
+    //transitions are never played or changed keeps only the pointer
+    if (!_items.empty() || _data == nullptr)
+        return;
+
+    _items.reserve(_data->items.size());
+    for (auto &it : _data->items)
+        _items.push_back(new TransitionItem(it));
 }
 
 void Transition::setAutoPlay(bool value)
@@ -178,6 +235,7 @@ void Transition::changeRepeat(int value)
 void Transition::play(int times, float delay, PlayCompleteCallback onComplete, bool reverse)
 {
     stop(true, true);
+    ensureItems();
 
     _totalTimes = times;
     _reversed = reverse;
@@ -253,19 +311,19 @@ void Transition::stopItem(TransitionItem * item, bool setToComplete)
         item->displayLockToken = 0;
     }
 
-    //if (item->type == TransitionActionType::ColorFilter && item->filterCreated)
+    //if (item->data->type == TransitionActionType::ColorFilter && item->filterCreated)
       //  item->target->setFilter(nullptr);
 
     if (item->completed)
         return;
 
-    if (item->type == TransitionActionType::Transition)
+    if (item->data->type == TransitionActionType::Transition)
     {
         Transition* trans = item->target->as<GComponent>()->getTransition(item->value.s);
         if (trans != nullptr)
             trans->stop(setToComplete, false);
     }
-    else if (item->type == TransitionActionType::Shake)
+    else if (item->data->type == TransitionActionType::Shake)
     {
         _owner->getScheduler()->unschedule("-", item);
 
@@ -277,14 +335,14 @@ void Transition::stopItem(TransitionItem * item, bool setToComplete)
     {
         if (setToComplete)
         {
-            if (item->tween)
+            if (item->data->tween)
             {
-                if (!item->yoyo || item->repeat % 2 == 0)
+                if (!item->data->yoyo || item->data->repeat % 2 == 0)
                     applyValue(item, _reversed ? item->startValue : item->endValue);
                 else
                     applyValue(item, _reversed ? item->endValue : item->startValue);
             }
-            else if (item->type != TransitionActionType::Sound)
+            else if (item->data->type != TransitionActionType::Sound)
                 applyValue(item, item->value);
         }
     }
@@ -292,24 +350,26 @@ void Transition::stopItem(TransitionItem * item, bool setToComplete)
 
 void Transition::setValue(const std::string & label, const ValueVector& values)
 {
+    ensureItems();
+
     for (auto &item : _items)
     {
         TransitionValue& value = item->startValue;
-        if (item->label == label)
+        if (item->data->label == label)
         {
-            if (item->tween)
+            if (item->data->tween)
                 value = item->startValue;
             else
                 value = item->value;
         }
-        else if (item->label2 == label)
+        else if (item->data->label2 == label)
         {
             value = item->endValue;
         }
         else
             continue;
 
-        switch (item->type)
+        switch (item->data->type)
         {
         case TransitionActionType::XY:
         case TransitionActionType::Size:
@@ -380,14 +440,16 @@ void Transition::setValue(const std::string & label, const ValueVector& values)
 
 void Transition::setHook(const std::string & label, TransitionHook callback)
 {
+    ensureItems();
+
     for (auto &item : _items)
     {
-        if (item->label == label)
+        if (item->data->label == label)
         {
             item->hook = callback;
             break;
         }
-        else if (item->label2 == label)
+        else if (item->data->label2 == label)
         {
             item->hook2 = callback;
             break;
@@ -406,34 +468,56 @@ void Transition::clearHooks()
 
 void Transition::setTarget(const std::string & label, GObject * newTarget)
 {
+    ensureItems();
+
     for (auto &item : _items)
     {
-        if (item->label == label)
+        if (item->data->label == label)
             item->targetId = newTarget->id;
     }
 }
 
 void Transition::setDuration(const std::string & label, float value)
 {
+    ensureItems();
+
     for (auto &item : _items)
     {
-        if (item->tween && item->label == label)
+        if (item->data->tween && item->data->label == label)
             item->duration = value;
     }
 }
 
 void Transition::updateFromRelations(const std::string & targetId, float dx, float dy)
 {
+    if (_items.empty())
+    {
+        if (_data == nullptr)
+            return;
+
+        bool found = false;
+        for (auto &it : _data->items)
+        {
+            if (it->type == TransitionActionType::XY && it->targetId == targetId)
+            {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return;
+
+        ensureItems();
+    }
+
     int cnt = (int)_items.size();
-    if (cnt == 0)
-        return;
 
     for (int i = 0; i < cnt; i++)
     {
         TransitionItem* item = _items[i];
-        if (item->type == TransitionActionType::XY && item->targetId == targetId)
+        if (item->data->type == TransitionActionType::XY && item->targetId == targetId)
         {
-            if (item->tween)
+            if (item->data->tween)
             {
                 item->startValue.f1 += dx;
                 item->startValue.f2 += dy;
@@ -455,6 +539,15 @@ void Transition::OnOwnerRemovedFromStage()
         stop((_options & OPTION_AUTO_STOP_AT_END) != 0 ? true : false, false);
 }
 
+size_t Transition::getMemoryUsage() const
+{
+    //the shared TransitionData is counted with the package
+    size_t bytes = sizeof(Transition) + MemoryStats::stringBytes(name) + _items.capacity() * sizeof(TransitionItem*);
+    for (auto &item : _items)
+        bytes += sizeof(TransitionItem) + MemoryStats::stringBytes(item->targetId);
+    return bytes;
+}
+
 void Transition::internalPlay(float delay)
 {
     _ownerBaseX = _owner->getX();
@@ -470,14 +563,14 @@ void Transition::internalPlay(float delay)
         if (item->target == nullptr)
             continue;
 
-        if (item->tween)
+        if (item->data->tween)
         {
             float startTime = delay;
             if (_reversed)
-                startTime += (_maxTime - item->time - item->duration);
+                startTime += (_maxTime - item->data->time - item->duration);
             else
-                startTime += item->time;
-            if (startTime > 0 && (item->type == TransitionActionType::XY || item->type == TransitionActionType::Size))
+                startTime += item->data->time;
+            if (startTime > 0 && (item->data->type == TransitionActionType::XY || item->data->type == TransitionActionType::Size))
             {
                 _totalTasks++;
                 item->completed = false;
@@ -497,9 +590,9 @@ void Transition::internalPlay(float delay)
         {
             float startTime = delay;
             if (_reversed)
-                startTime += (_maxTime - item->time);
+                startTime += (_maxTime - item->data->time);
             else
-                startTime += item->time;
+                startTime += item->data->time;
             if (startTime == 0)
                 applyValue(item, item->value);
             else
@@ -526,6 +619,7 @@ void Transition::internalPlay(float delay)
 
 void Transition::startTween(TransitionItem * item, float delay)
 {
+    FGUI_PROFILE_ZONE("Transition::startTween");
     TransitionValue& startValue = item->startValue;
     TransitionValue& endValue = item->endValue;
 
@@ -537,12 +631,12 @@ void Transition::startTween(TransitionItem * item, float delay)
 
     ActionInterval* mainAction = nullptr;
 
-    switch (item->type)
+    switch (item->data->type)
     {
     case TransitionActionType::XY:
     case TransitionActionType::Size:
     {
-        if (item->type == TransitionActionType::XY)
+        if (item->data->type == TransitionActionType::XY)
         {
             if (item->target == _owner)
             {
@@ -662,9 +756,9 @@ void Transition::startTween(TransitionItem * item, float delay)
         break;
     }
 
-    mainAction = ActionUtils::createEaseAction(item->easeType, mainAction);
-    if (item->repeat != 0)
-        mainAction = RepeatYoyo::create(mainAction, item->repeat == -1 ? INT_MAX : (item->repeat + 1), item->yoyo);
+    mainAction = ActionUtils::createEaseAction(item->data->easeType, mainAction);
+    if (item->data->repeat != 0)
+        mainAction = RepeatYoyo::create(mainAction, item->data->repeat == -1 ? INT_MAX : (item->data->repeat + 1), item->data->yoyo);
 
     FiniteTimeAction* completeAction = CallFunc::create([this, item]() { tweenComplete(item); });
     if (delay > 0)
@@ -751,7 +845,7 @@ void Transition::applyValue(TransitionItem * item, TransitionValue & value)
 {
     item->target->_gearLocked = true;
 
-    switch (item->type)
+    switch (item->data->type)
     {
     case TransitionActionType::XY:
         if (item->target == _owner)
@@ -915,7 +1009,33 @@ void Transition::shakeItem(float dt, TransitionItem * item)
     }
 }
 
-void Transition::decodeValue(TransitionActionType type, const char* pValue, TransitionValue & value)
+TransitionData::TransitionData() :
+    options(0),
+    autoPlay(false),
+    autoPlayRepeat(1),
+    autoPlayDelay(0),
+    maxTime(0)
+{
+}
+
+TransitionData::~TransitionData()
+{
+    for (auto &item : items)
+        delete item;
+}
+
+size_t TransitionData::getMemoryUsage() const
+{
+    size_t bytes = sizeof(TransitionData) + MemoryStats::stringBytes(name) + items.capacity() * sizeof(TransitionItemData*);
+    for (auto &item : items)
+    {
+        bytes += sizeof(TransitionItemData) + MemoryStats::stringBytes(item->targetId)
+            + MemoryStats::stringBytes(item->label) + MemoryStats::stringBytes(item->label2);
+    }
+    return bytes;
+}
+
+static void decodeValue(TransitionActionType type, const char* pValue, TransitionValue & value)
 {
     std::string str;
     if (pValue)
@@ -1044,15 +1164,15 @@ void Transition::decodeValue(TransitionActionType type, const char* pValue, Tran
     }
 }
 
-void Transition::setup(TXMLElement * xml)
+void TransitionData::setup(TXMLElement * xml)
 {
     const char* p;
     name = xml->Attribute("name");
     p = xml->Attribute("options");
     if (p)
-        _options = atoi(p);
-    _autoPlay = xml->BoolAttribute("autoPlay");
-    if (_autoPlay)
+        options = atoi(p);
+    autoPlay = xml->BoolAttribute("autoPlay");
+    if (autoPlay)
     {
         p = xml->Attribute("autoPlayRepeat");
         if (p)
@@ -1063,8 +1183,8 @@ void Transition::setup(TXMLElement * xml)
     TXMLElement* cxml = xml->FirstChildElement("item");
     while (cxml)
     {
-        TransitionItem* item = new TransitionItem();
-        _items.push_back(item);
+        TransitionItemData* item = new TransitionItemData();
+        items.push_back(item);
 
         item->time = (float)cxml->IntAttribute("time") / (float)FRAME_RATE;
         p = cxml->Attribute("target");
@@ -1080,8 +1200,8 @@ void Transition::setup(TXMLElement * xml)
         if (item->tween)
         {
             item->duration = (float)cxml->IntAttribute("duration") / FRAME_RATE;
-            if (item->time + item->duration > _maxTime)
-                _maxTime = item->time + item->duration;
+            if (item->time + item->duration > maxTime)
+                maxTime = item->time + item->duration;
 
             p = cxml->Attribute("ease");
             if (p)
@@ -1107,8 +1227,8 @@ void Transition::setup(TXMLElement * xml)
         }
         else
         {
-            if (item->time > _maxTime)
-                _maxTime = item->time;
+            if (item->time > maxTime)
+                maxTime = item->time;
             decodeValue(item->type, cxml->Attribute("value"), item->value);
         }
 
@@ -2,17 +2,45 @@
 #define __TRANSITION_H__
 
 #include "FGUIMacros.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
 class GObject;
 class GComponent;
 class TransitionItem;
+class TransitionItemData;
 class TransitionValue;
 
+//The decoded form of one <transition> element. It is built once when the component
+//PackageItem is loaded and shared by every instance of the component; it is never
+//modified afterwards, per-instance changes live in the Transition.
+class FGUI_IMPEXP TransitionData : public Ref
+{
+public:
+    TransitionData();
+    virtual ~TransitionData();
+
+    void setup(TXMLElement* xml);
+    size_t getMemoryUsage() const;
+
+    std::string name;
+    int options;
+    bool autoPlay;
+    int autoPlayRepeat;
+    float autoPlayDelay;
+    float maxTime;
+    std::vector<TransitionItemData*> items;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(TransitionData);
+};
+
 class FGUI_IMPEXP Transition : public Ref
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     typedef std::function<void()> PlayCompleteCallback;
     typedef std::function<void()> TransitionHook;
 
@@ -40,8 +68,9 @@ public:
 
     void updateFromRelations(const std::string& targetId, float dx, float dy);
     void OnOwnerRemovedFromStage();
+    size_t getMemoryUsage() const;
 
-    void setup(TXMLElement* xml);
+    void setup(TransitionData* data);
 
     std::string name;
     int autoPlayRepeat;
@@ -57,10 +86,10 @@ private:
     void applyValue(TransitionItem* item, TransitionValue& value);
     void playTransComplete(TransitionItem* item);
     void shakeItem(float dt, TransitionItem* item);
-
-    void decodeValue(TransitionActionType type, const char* pValue, TransitionValue& value);
+    void ensureItems();
 
     GComponent* _owner;
+    TransitionData* _data;
     std::vector<TransitionItem*> _items;
     int _totalTimes;
     int _totalTasks;
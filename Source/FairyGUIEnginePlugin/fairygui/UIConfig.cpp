@@ -25,6 +25,20 @@ std::string UIConfig::popupMenu = "";
 std::string UIConfig::popupMenu_seperator = "";
 float UIConfig::inputCaretSize = 1;
 VColorRef UIConfig::inputHighlightColor = VColorRef(255, 223, 141, 128);
+float UIConfig::textureIdleTimeout = 0;
+int UIConfig::textureMemoryBudget = 0;
+int UIConfig::externalTextureCacheSize = 32 * 1024 * 1024;
+int UIConfig::dynamicAtlasPageSize = 1024;
+int UIConfig::dynamicAtlasMaxPages = 4;
+int UIConfig::dynamicAtlasMaxTextureSize = 256;
+int UIConfig::workerThreadCount = -1;
+int UIConfig::parallelRebuildThreshold = 64;
+int UIConfig::virtualListPrefetchCount = 20;
+float UIConfig::virtualListOverscan = 0;
+float UIConfig::virtualListRenderBudget = 0;
+std::string UIConfig::virtualListPlaceholder = "";
+bool UIConfig::memoryMappedPackages = true;
+bool UIConfig::componentArenas = false;
 
 NS_FGUI_END
 
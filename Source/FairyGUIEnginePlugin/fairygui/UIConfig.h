@@ -31,6 +31,20 @@ public:
     static std::string popupMenu_seperator;
     static float inputCaretSize;
     static VColorRef inputHighlightColor;
+    static float textureIdleTimeout;
+    static int textureMemoryBudget;
+    static int externalTextureCacheSize;
+    static int dynamicAtlasPageSize;
+    static int dynamicAtlasMaxPages;
+    static int dynamicAtlasMaxTextureSize;
+    static int workerThreadCount;
+    static int parallelRebuildThreshold;
+    static int virtualListPrefetchCount;
+    static float virtualListOverscan;
+    static float virtualListRenderBudget;
+    static std::string virtualListPlaceholder;
+    static bool memoryMappedPackages;
+    static bool componentArenas;
 
 private:
 };
@@ -1,11 +1,17 @@
 #include "UIPackage.h"
 #include "UIObjectFactory.h"
+#include "UIConfig.h"
 #include "GComponent.h"
 #include "FGUIManager.h"
 #include "core/HitTest.h"
 #include "core/BitmapFont.h"
+#include "core/TextureResidencyManager.h"
+#include "core/TextMeasurer.h"
 #include "utils/ByteArray.h"
 #include "utils/ToolSet.h"
+#include "utils/Profiler.h"
+#include "utils/MemoryStats.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
@@ -15,7 +21,8 @@ int UIPackage::_constructing = 0;
 std::unordered_map<std::string, UIPackage*> UIPackage::_packageInstById;
 std::unordered_map<std::string, UIPackage*> UIPackage::_packageInstByName;
 std::vector<UIPackage*> UIPackage::_packageList;
-std::unordered_map<std::string, ValueMap> UIPackage::_stringsSource;
+StringTable UIPackage::_strings;
+std::vector<GObject*> UIPackage::_translatedObjects;
 
 struct AtlasSprite
 {
@@ -31,8 +38,16 @@ UIPackage::UIPackage() :
 
 UIPackage::~UIPackage()
 {
+    //null when the manager is shutting down, the measuring thread is already stopped then
+    TextMeasurer* measurer = FGUIManager::GlobalManager().getTextMeasurer();
     for (auto &it : _items)
+    {
+        if (it->type == PackageItemType::ATLAS && it->texture != nullptr)
+            FGUIManager::GlobalManager().getTextureResidencyManager()->removeTexture(it->texture);
+        else if (it->bitmapFont != nullptr && measurer != nullptr)
+            measurer->releaseFont(it->bitmapFont);
         delete it;
+    }
     for (auto &it : _hitTestDatas)
         delete it.second;
 }
@@ -219,6 +234,7 @@ void UIPackage::loadItem(const std::string& resName)
 
 void UIPackage::loadItem(PackageItem * item)
 {
+    FGUI_PROFILE_ZONE("UIPackage::loadItem");
     switch (item->type)
     {
     case PackageItemType::IMAGE:
@@ -281,7 +297,7 @@ void UIPackage::loadItem(PackageItem * item)
         if (!_loadingPackage && !item->displayList)
         {
             loadComponentChildren(item);
-            translateComponent(item);
+            loadComponentTransitions(item);
         }
         break;
     default:
@@ -298,57 +314,142 @@ PixelHitTestData * UIPackage::getPixelHitTestData(const std::string & itemId)
         return nullptr;
 }
 
+void UIPackage::collectMemoryStats(MemoryStats & stats) const
+{
+    size_t bytes = sizeof(UIPackage) + _items.capacity() * sizeof(PackageItem*)
+        + MemoryStats::mapBytes(_itemsById) + MemoryStats::mapBytes(_itemsByName);
+    for (auto &it : _items)
+    {
+        bytes += sizeof(PackageItem) + MemoryStats::stringBytes(it->id)
+            + MemoryStats::stringBytes(it->name) + MemoryStats::stringBytes(it->file);
 
-void UIPackage::setStringsSource(const char *xmlString, size_t nBytes)
+        switch (it->type)
+        {
+        case PackageItemType::ATLAS:
+            if (it->texture != nullptr && it->texture->getNativeTexture() != nullptr
+                && it->texture->getNativeTexture()->IsLoaded())
+                stats.addTexture(_name + "/" + it->file, TextureResidencyManager::getTextureBytes(it->texture));
+            break;
+
+        case PackageItemType::IMAGE:
+            if (it->texture != nullptr)
+                bytes += sizeof(NTexture);
+            if (it->scale9Grid != nullptr)
+                bytes += sizeof(VRectanglef);
+            break;
+
+        case PackageItemType::MOVIECLIP:
+            if (it->frames != nullptr)
+                bytes += sizeof(MovieClip::Frames) + it->frames->items.GetCapacity() * sizeof(MovieClip::Frame);
+            break;
+
+        case PackageItemType::COMPONENT:
+        {
+            size_t xml = MemoryStats::xmlBytes(it->componentData);
+            if (it->displayList != nullptr)
+            {
+                xml += sizeof(std::vector<DisplayListItem*>) + it->displayList->capacity() * sizeof(DisplayListItem*);
+                for (auto &di : *it->displayList)
+                    xml += sizeof(DisplayListItem) + MemoryStats::stringBytes(di->type);
+            }
+            stats.add(MemoryStats::XML_DOM, xml);
+
+            size_t trans = it->transitions.capacity() * sizeof(TransitionData*);
+            for (auto &data : it->transitions)
+                trans += data->getMemoryUsage();
+            stats.add(MemoryStats::CONTROLLERS_TRANSITIONS, trans);
+            break;
+        }
+
+        case PackageItemType::FONT:
+            if (it->bitmapFont != nullptr)
+                stats.add(MemoryStats::FONTS, it->bitmapFont->getMemoryUsage());
+            break;
+
+        default:
+            break;
+        }
+    }
+    stats.add(MemoryStats::OTHER, bytes);
+
+    //only alive while the package is loading, a mapped archive is not heap memory
+    stats.add(MemoryStats::XML_DOM, (_descFile.isMapped() ? 0 : _descFile.getSize()) + MemoryStats::mapBytes(_descPack));
+
+    bytes = MemoryStats::mapBytes(_hitTestDatas);
+    for (auto &it : _hitTestDatas)
+        bytes += sizeof(PixelHitTestData) + it.second->pixelsLength;
+    stats.add(MemoryStats::HIT_TEST, bytes);
+}
+
+void UIPackage::collectAllMemoryStats(MemoryStats & stats)
 {
-    _stringsSource.clear();
+    for (auto &it : _packageList)
+        it->collectMemoryStats(stats);
+}
 
-    TXMLDocument* xml = new TXMLDocument();
-    xml->Parse(xmlString, nBytes);
 
-    TXMLElement* root = xml->RootElement();
-    TXMLElement* ele = root->FirstChildElement("string");
-    while (ele)
-    {
-        std::string key = ele->Attribute("name");
-        std::string text = ele->GetText();
-        size_t i = key.find("-");
-        if (i == std::string::npos)
-            continue;
+void UIPackage::setStringsSource(const char *xmlString, size_t nBytes)
+{
+    _strings.parse(xmlString, nBytes);
+    applyStrings();
+}
 
-        std::string key2 = key.substr(0, i);
-        std::string key3 = key.substr(i + 1);
-        ValueMap& col = _stringsSource[key2];
-        col[key3] = text;
+bool UIPackage::loadStrings(const std::string & filePath)
+{
+    if (!_strings.load(filePath))
+        return false;
 
-        ele = ele->NextSiblingElement("string");
+    applyStrings();
+    return true;
+}
+
+void UIPackage::applyStrings()
+{
+    //by index, setting a text does not create or dispose objects but stays safe if it ever does
+    //gears are locked, a translated text is not a state change of the current controller page
+    for (size_t i = 0; i < _translatedObjects.size(); i++)
+    {
+        GObject* obj = _translatedObjects[i];
+        obj->_gearLocked = true;
+        obj->applyStrings(_strings);
+        obj->_gearLocked = false;
     }
+}
 
-    delete xml;
+void UIPackage::addTranslatedObject(GObject * obj)
+{
+    obj->_stringsIndex = (int)_translatedObjects.size();
+    _translatedObjects.push_back(obj);
+}
+
+void UIPackage::removeTranslatedObject(GObject * obj)
+{
+    GObject* last = _translatedObjects.back();
+    _translatedObjects[obj->_stringsIndex] = last;
+    last->_stringsIndex = obj->_stringsIndex;
+    _translatedObjects.pop_back();
+    obj->_stringsIndex = -1;
 }
 
 void UIPackage::create(const std::string& assetPath)
 {
-    IVFileInStream* stream = VFileAccessManager::GetInstance()->Open((assetPath + ".bytes").c_str());
-    if (stream == nullptr)
+    if (!_descFile.open(assetPath + ".bytes"))
     {
         CCLOGERROR("FairyGUI: cannot load package from '%s'", assetPath.c_str());
         return;
     }
-    hkvArray<char> buffer;
-    buffer.SetSize(stream->GetSize());
-    stream->Read(buffer.GetData(), buffer.GetSize());
-    stream->Close();
 
     _assetNamePrefix = assetPath + "@";
-    decodeDesc(buffer);
+    decodeDesc();
 
     loadPackage();
 }
 
-void UIPackage::decodeDesc(hkvArray<char>& buffer)
+void UIPackage::decodeDesc()
 {
-    ByteArray* ba = ByteArray::createWithBuffer((char *)buffer.GetData(), buffer.GetSize());
+    //The entries are stored uncompressed, so they are referenced in place
+    //and _descFile is the only copy of the archive.
+    ByteArray* ba = ByteArray::createView(_descFile.getData(), _descFile.getSize());
 
     size_t pos = ba->getLength() - 22;
     ba->setPosition(pos + 10);
@@ -372,13 +473,8 @@ void UIPackage::decodeDesc(hkvArray<char>& buffer)
             ba->setPosition(pos + 42);
             int offset = ba->readInt() + 30 + len;
 
-            if (size > 0)
-            {
-                hkvArray<char>* data = new hkvArray<char>();
-                data->SetSize(size);
-                memcpy(data->GetDataPointer(), buffer.GetData() + offset, size);
-                _descPack[entryName] = data;
-            }
+            if (size > 0 && (size_t)(offset + size) <= _descFile.getSize())
+                _descPack[entryName] = ByteSpan(_descFile.getData() + offset, size);
         }
 
         pos += 46 + len + len2;
@@ -389,16 +485,12 @@ void UIPackage::decodeDesc(hkvArray<char>& buffer)
 
 void UIPackage::loadPackage()
 {
-    IVFileInStream* stream = VFileAccessManager::GetInstance()->Open((_assetNamePrefix + "sprites.bytes").c_str());
-    if (stream == nullptr)
+    MappedFile spritesFile;
+    if (!spritesFile.open(_assetNamePrefix + "sprites.bytes"))
     {
         CCLOGERROR("FairyGUI: cannot load package from '%s'", _assetNamePrefix.c_str());
         return;
     }
-    hkvArray<char> buffer;
-    buffer.SetSize(stream->GetSize());
-    stream->Read(buffer.GetData(), buffer.GetSize());
-    stream->Close();
 
     _loadingPackage = true;
 
@@ -406,7 +498,8 @@ void UIPackage::loadPackage()
     std::vector<std::string> arr;
     std::string str;
 
-    ToolSet::splitString(std::string(buffer.GetData(), buffer.GetSize()), '\n', lines);
+    ToolSet::splitString(std::string(spritesFile.getData(), spritesFile.getSize()), '\n', lines);
+    spritesFile.close();
     size_t cnt = lines.size();
     for (size_t i = 1; i < cnt; i++)
     {
@@ -436,15 +529,10 @@ void UIPackage::loadPackage()
         _sprites[itemId] = sprite;
     }
 
-    stream = VFileAccessManager::GetInstance()->Open((_assetNamePrefix + "hittest.bytes").c_str());
-    if (stream)
+    MappedFile hitTestFile;
+    if (hitTestFile.open(_assetNamePrefix + "hittest.bytes"))
     {
-        hkvArray<char> tmpBuffer;
-        tmpBuffer.SetSize(stream->GetSize());
-        stream->Read(tmpBuffer.GetData(), tmpBuffer.GetSize());
-        stream->Close();
-
-        ByteArray* ba = ByteArray::createWithBuffer(tmpBuffer.GetData(), tmpBuffer.GetSize(), false);
+        ByteArray* ba = ByteArray::createView(hitTestFile.getData(), hitTestFile.getSize());
         ba->setEndian(ByteArray::ENDIAN_BIG);
         while (ba->getBytesAvailable())
         {
@@ -455,10 +543,10 @@ void UIPackage::loadPackage()
         delete ba;
     }
 
-    hkvArray<char>* xmlData = _descPack["package.xml"];
+    const ByteSpan& xmlData = _descPack["package.xml"];
 
     TXMLDocument* xml = new TXMLDocument();
-    xml->Parse((const char*)xmlData->GetData(), xmlData->GetSize());
+    xml->Parse(xmlData.data, xmlData.length);
 
     TXMLElement* root = xml->RootElement();
 
@@ -551,9 +639,8 @@ void UIPackage::loadPackage()
     for (auto &iter : _items)
         loadItem(iter);
 
-    for (auto &iter : _descPack)
-        delete iter.second;
     _descPack.clear();
+    _descFile.close();
 
     for (auto &iter : _sprites)
         delete iter.second;
@@ -570,6 +657,8 @@ NTexture* UIPackage::createSpriteTexture(AtlasSprite * sprite)
     {
         loadItem(atlasItem);
         atlasTexture = atlasItem->texture;
+        //the uv rect is computed from the native size, make sure an evicted atlas is back
+        FGUIManager::GlobalManager().getTextureResidencyManager()->touch(atlasTexture);
     }
     else
     {
@@ -587,6 +676,7 @@ void UIPackage::loadAtlas(PackageItem * item)
     if (tex)
     {
         item->texture = new NTexture(tex);
+        FGUIManager::GlobalManager().getTextureResidencyManager()->addTexture(item->texture);
     }
     else
     {
@@ -610,9 +700,9 @@ void UIPackage::loadSound(PackageItem * item)
 
 void UIPackage::loadMovieClip(PackageItem * item)
 {
-    hkvArray<char>* xmlData = _descPack[item->id + ".xml"];
+    const ByteSpan& xmlData = _descPack[item->id + ".xml"];
     TXMLDocument* xml = new TXMLDocument();
-    xml->Parse((const char*)xmlData->GetData(), xmlData->GetSize());
+    xml->Parse(xmlData.data, xmlData.length);
 
     TXMLElement* root = xml->RootElement();
 
@@ -621,7 +711,8 @@ void UIPackage::loadMovieClip(PackageItem * item)
     bool swing = root->BoolAttribute("swing");
 
     int frameCount = root->IntAttribute("frameCount");
-    item->frames.SetSize(frameCount);
+    item->frames = new MovieClip::Frames();
+    item->frames->items.SetSize(frameCount);
 
     int i = 0;
     std::string spriteId;
@@ -633,7 +724,7 @@ void UIPackage::loadMovieClip(PackageItem * item)
     TXMLElement* frameEle = framesEle->FirstChildElement("frame");
     while (frameEle)
     {
-        MovieClip::Frame& frame = item->frames[i];
+        MovieClip::Frame& frame = item->frames->items[i];
         ToolSet::splitString(frameEle->Attribute("rect"), ',', arr);
         frame.rect.m_vMin.x = atoi(arr[0].c_str());
         frame.rect.m_vMin.y = atoi(arr[1].c_str());
@@ -692,10 +783,10 @@ void UIPackage::loadMovieClip(PackageItem * item)
 
 void UIPackage::loadFont(PackageItem * item)
 {
-    hkvArray<char>* fntData = _descPack[item->id + ".fnt"];
+    const ByteSpan& fntData = _descPack[item->id + ".fnt"];
 
     FastSplitter lines, props, fields;
-    lines.start((char*)fntData->GetData(), fntData->GetSize(), '\n');
+    lines.start(fntData.data, fntData.length, '\n');
     bool ttf = false;
     int size = 0;
     int xadvance = 0;
@@ -821,7 +912,10 @@ void UIPackage::loadFont(PackageItem * item)
                 def.width = charImg->texture->getWidth();
                 def.height = charImg->texture->getHeight();
                 if (mainTexture == nullptr)
-                    mainTexture = new NTexture(charImg->texture->getNativeTexture());
+                {
+                    mainTexture = charImg->texture->getRoot();
+                    mainTexture->retain();
+                }
 
                 if (def.advance == 0)
                 {
@@ -842,7 +936,28 @@ void UIPackage::loadFont(PackageItem * item)
             if (size == 0)
                 size = def.height;
 
-            item->bitmapFont->chars[charId] = def;
+            item->bitmapFont->addGlyph(charId, def);
+        }
+        else if (len > 7 && memcmp(line, "kerning", 7) == 0 && line[7] == ' ')
+        {
+            hkUint32 first = 0, second = 0;
+            int amount = 0;
+
+            props.start(line, len, ' ');
+            while (props.next())
+            {
+                props.getKeyValuePair(keyBuf, sizeof(keyBuf), valueBuf, sizeof(valueBuf));
+
+                if (strcmp(keyBuf, "first") == 0)
+                    sscanf(valueBuf, "%u", &first);
+                else if (strcmp(keyBuf, "second") == 0)
+                    sscanf(valueBuf, "%u", &second);
+                else if (strcmp(keyBuf, "amount") == 0)
+                    sscanf(valueBuf, "%d", &amount);
+            }
+
+            if (amount != 0)
+                item->bitmapFont->addKerning(first, second, amount);
         }
     }
 
@@ -855,9 +970,9 @@ void UIPackage::loadFont(PackageItem * item)
 
 void UIPackage::loadComponent(PackageItem * item)
 {
-    hkvArray<char>* xmlData = _descPack[item->id + ".xml"];
+    const ByteSpan& xmlData = _descPack[item->id + ".xml"];
     TXMLDocument* doc = new TXMLDocument();
-    doc->Parse((const char*)xmlData->GetData(), xmlData->GetSize());
+    doc->Parse(xmlData.data, xmlData.length);
     item->componentData = doc;
 }
 
@@ -865,6 +980,7 @@ void UIPackage::loadComponentChildren(PackageItem * item)
 {
     TXMLElement* listNode = item->componentData->RootElement()->FirstChildElement("displayList");
     item->displayList = new std::vector<DisplayListItem*>();
+    item->stringsId = StringTable::intern(_id + item->id);
     const char *p;
     if (listNode)
     {
@@ -898,6 +1014,7 @@ void UIPackage::loadComponentChildren(PackageItem * item)
             }
 
             di->desc = cxml;
+            di->stringsId = StringTable::intern(cxml->Attribute("id"));
             item->displayList->push_back(di);
 
             cxml = cxml->NextSiblingElement();
@@ -905,137 +1022,17 @@ void UIPackage::loadComponentChildren(PackageItem * item)
     }
 }
 
-void UIPackage::translateComponent(PackageItem * item)
+void UIPackage::loadComponentTransitions(PackageItem * item)
 {
-    if (_stringsSource.empty())
-        return;
-
-    auto it = _stringsSource.find(_id + item->id);
-    if (it == _stringsSource.end())
-        return;
-
-    const ValueMap& strings = it->second;
-    std::string ename, elementId, value;
-    const char* p;
-    int dcnt = item->displayList->size();
-    for (int i = 0; i < dcnt; i++)
+    TXMLElement* exml = item->componentData->RootElement()->FirstChildElement("transition");
+    while (exml)
     {
-        TXMLElement* cxml = item->displayList->at(i)->desc;
-        ename = cxml->Name();
-        elementId = (p = cxml->Attribute("id")) ? p : STD_STRING_EMPTY;
-        if (p = cxml->Attribute("tooltips"))
-        {
-            auto it = strings.find(elementId + "-tips");
-            if (it != strings.end())
-                cxml->SetAttribute("tooltips", it->second.asString().c_str());
-        }
-
-        TXMLElement* dxml = cxml->FirstChildElement("gearText");
-        if (dxml != nullptr)
-        {
-            {
-                auto it = strings.find(elementId + "-texts");
-                if (it != strings.end())
-                    dxml->SetAttribute("values", it->second.asString().c_str());
-            }
-
-            {
-                auto it = strings.find(elementId + "-texts_def");
-                if (it != strings.end())
-                    dxml->SetAttribute("default", it->second.asString().c_str());
-            }
-        }
-
-        if (ename == "text" || ename == "richtext")
-        {
-            {
-                auto it = strings.find(elementId);
-                if (it != strings.end())
-                    cxml->SetAttribute("text", it->second.asString().c_str());
-            }
-
-            {
-                auto it = strings.find(elementId + "-prompt");
-                if (it != strings.end())
-                    cxml->SetAttribute("prompt", it->second.asString().c_str());
-            }
-        }
-        else if (ename == "list")
-        {
-            TXMLElement* exml = cxml->FirstChildElement("item");
-            int j = 0;
-            while (exml)
-            {
-                auto it = strings.find(elementId + "-" + Value(j).asString());
-                if (it != strings.end())
-                    exml->SetAttribute("title", it->second.asString().c_str());
-
-                exml = exml->NextSiblingElement("item");
-                j++;
-            }
-        }
-        else if (ename == "component")
-        {
-            dxml = cxml->FirstChildElement("Button");
-            if (dxml != nullptr)
-            {
-                {
-                    auto it = strings.find(elementId);
-                    if (it != strings.end())
-                        dxml->SetAttribute("title", it->second.asString().c_str());
-                }
+        TransitionData* data = new TransitionData();
+        item->transitions.pushBack(data);
+        data->release();
+        data->setup(exml);
 
-                {
-                    auto it = strings.find(elementId + "-0");
-                    if (it != strings.end())
-                        dxml->SetAttribute("selectedTitle", it->second.asString().c_str());
-                }
-
-                continue;
-            }
-
-            dxml = cxml->FirstChildElement("Label");
-            if (dxml != nullptr)
-            {
-                {
-                    auto it = strings.find(elementId);
-                    if (it != strings.end())
-                        dxml->SetAttribute("title", it->second.asString().c_str());
-                }
-
-                {
-                    auto it = strings.find(elementId + "-prompt");
-                    if (it != strings.end())
-                        dxml->SetAttribute("prompt", it->second.asString().c_str());
-                }
-
-                continue;
-            }
-
-            dxml = cxml->FirstChildElement("ComboBox");
-            if (dxml != nullptr)
-            {
-                {
-                    auto it = strings.find(elementId);
-                    if (it != strings.end())
-                        dxml->SetAttribute("title", it->second.asString().c_str());
-                }
-
-                TXMLElement* exml = dxml->FirstChildElement("item");
-                int j = 0;
-                while (exml)
-                {
-                    auto it = strings.find(elementId + "-" + Value(j).asString());
-                    if (it != strings.end())
-                        exml->SetAttribute("title", it->second.asString().c_str());
-
-                    exml = exml->NextSiblingElement("item");
-                    j++;
-                }
-
-                continue;
-            }
-        }
+        exml = exml->NextSiblingElement("transition");
     }
 }
 
@@ -1051,13 +1048,31 @@ GObject * UIPackage::createObject(PackageItem * item)
 {
     loadItem(item);
 
+    //a component created from the outside gets its own arena, the nested ones share it
+    SlabArena* arena = nullptr;
+    if (UIConfig::componentArenas && _constructing == 0 && item->type == PackageItemType::COMPONENT)
+    {
+        arena = SlabArena::create();
+        arena->makeCurrent();
+    }
+
     GObject* g = UIObjectFactory::newObject(item);
-    if (g == nullptr)
-        return nullptr;
+    if (g != nullptr)
+    {
+        _constructing++;
+        g->constructFromResource();
+        _constructing--;
+    }
 
-    _constructing++;
-    g->constructFromResource();
-    _constructing--;
+    if (arena != nullptr)
+    {
+        arena->restoreCurrent();
+        GComponent* com = dynamic_cast<GComponent*>(g);
+        if (com != nullptr)
+            com->_arena = arena;
+        else
+            arena->release();
+    }
     return g;
 }
 
@@ -3,12 +3,16 @@
 
 #include "FGUIMacros.h"
 #include "PackageItem.h"
+#include "utils/ByteArray.h"
+#include "utils/MappedFile.h"
+#include "StringTable.h"
 
 NS_FGUI_BEGIN
 
 struct AtlasSprite;
 class PixelHitTestData;
 class GObject;
+class MemoryStats;
 
 class FGUI_IMPEXP UIPackage
 {
@@ -26,7 +30,13 @@ public:
     static std::string getItemURL(const std::string& pkgName, const std::string& resName);
     static PackageItem* getItemByURL(const std::string& url);
     static std::string normalizeURL(const std::string& url);
+    //Both replace the strings of the current language and re-apply them to the objects
+    //created from packages that are still alive; an element the new table has no string
+    //for keeps its current text, and so does a text the game has set itself.
     static void setStringsSource(const char *xmlString, size_t nBytes);
+    static bool loadStrings(const std::string& filePath);
+    static const StringTable& getStrings() { return _strings; }
+    static void collectAllMemoryStats(MemoryStats& stats);
 
     const std::string& getId() const { return _id; }
     const std::string& getName() const { return _name; }
@@ -37,13 +47,14 @@ public:
     void loadItem(PackageItem* item);
 
     PixelHitTestData* getPixelHitTestData(const std::string& itemId);
+    void collectMemoryStats(MemoryStats& stats) const;
 
     static int _constructing;
     static const std::string URL_PREFIX;
 
 private:
     void create(const std::string& assetPath);
-    void decodeDesc(hkvArray<char>& data);
+    void decodeDesc();
     void loadPackage();
     NTexture* createSpriteTexture(AtlasSprite* sprite);
     void loadAtlas(PackageItem* item);
@@ -52,7 +63,11 @@ private:
     void loadFont(PackageItem* item);
     void loadComponent(PackageItem* item);
     void loadComponentChildren(PackageItem* item);
-    void translateComponent(PackageItem* item);
+    void loadComponentTransitions(PackageItem* item);
+
+    static void applyStrings();
+    static void addTranslatedObject(GObject* obj);
+    static void removeTranslatedObject(GObject* obj);
 
     GObject* createObject(const std::string& resName);
     GObject* createObject(PackageItem* item);
@@ -66,7 +81,8 @@ private:
     std::unordered_map<std::string, PackageItem*> _itemsById;
     std::unordered_map<std::string, PackageItem*> _itemsByName;
     std::unordered_map<std::string, AtlasSprite*> _sprites;
-    std::unordered_map<std::string, hkvArray<char>*> _descPack;
+    MappedFile _descFile;
+    std::unordered_map<std::string, ByteSpan> _descPack;
     std::unordered_map<std::string, PixelHitTestData*> _hitTestDatas;
     std::string _assetNamePrefix;
     std::string _customId;
@@ -75,7 +91,10 @@ private:
     static std::unordered_map<std::string, UIPackage*> _packageInstById;
     static std::unordered_map<std::string, UIPackage*> _packageInstByName;
     static std::vector<UIPackage*> _packageList;
-    static std::unordered_map<std::string, ValueMap> _stringsSource;
+    static StringTable _strings;
+    static std::vector<GObject*> _translatedObjects;
+
+    friend class GObject;
 };
 
 NS_FGUI_END
@@ -17,6 +17,7 @@ public:
 
     virtual const std::string& getName() const { return _fontName; }
     virtual NTexture* getTexture() const { return _texture; }
+    //The measuring methods are also called from the TextMeasurer thread and must not modify shared state.
     virtual int getCharacterIndexAtPos(const char *szText, const TextFormat & format, float fHorizPos, int iCharCount = -1) = 0;
     virtual bool getTextDimension(const char *szText, const TextFormat & format, VRectanglef &dest, int iCharCount = -1) = 0;
     virtual int getLineHeight(const TextFormat & format) = 0;
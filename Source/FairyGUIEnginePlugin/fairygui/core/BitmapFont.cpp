@@ -1,14 +1,106 @@
 #include "BitmapFont.h"
 #include "TextField.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
+static inline hkUint32 decodeUTF8(const char*& p, const char* end)
+{
+    unsigned char c = (unsigned char)*p++;
+    if (c < 0x80)
+        return c;
+
+    int extra;
+    hkUint32 ret;
+    if ((c & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        ret = c & 0x1F;
+    }
+    else if ((c & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        ret = c & 0x0F;
+    }
+    else if ((c & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        ret = c & 0x07;
+    }
+    else
+        return c;
+
+    for (; extra > 0 && p < end && ((unsigned char)*p & 0xC0) == 0x80; extra--)
+        ret = (ret << 6) | ((unsigned char)*p++ & 0x3F);
+    return ret;
+}
+
 BitmapFont::BitmapFont(const std::string & name) :BaseFont(name)
 {
+    memset(_latin, 0, sizeof(_latin));
+    memset(_pages, 0, sizeof(_pages));
 }
 
 BitmapFont::~BitmapFont()
 {
+    for (int i = 0; i < PAGE_SIZE; i++)
+        delete[] _pages[i];
+}
+
+void BitmapFont::addGlyph(hkUint32 charId, const BMGlyph & glyph)
+{
+    int* slot;
+    if (charId < PAGE_SIZE)
+        slot = &_latin[charId];
+    else if (charId < 0x10000)
+    {
+        int*& page = _pages[charId >> 8];
+        if (page == nullptr)
+        {
+            page = new int[PAGE_SIZE];
+            memset(page, 0, sizeof(int) * PAGE_SIZE);
+        }
+        slot = &page[charId & 0xFF];
+    }
+    else
+        slot = &_astral[charId];
+
+    if (*slot != 0)
+        _glyphs[*slot - 1] = glyph;
+    else
+    {
+        _glyphs.push_back(glyph);
+        *slot = (int)_glyphs.size();
+    }
+}
+
+void BitmapFont::addKerning(hkUint32 first, hkUint32 second, int amount)
+{
+    //kerning lines come after the char lines in a .fnt file, so the glyph is already there
+    const BMGlyph* glyph = getGlyph(first);
+    if (glyph == nullptr)
+        return;
+
+    _glyphs[glyph - &_glyphs[0]].kerning = true;
+    _kernings[((hkUint64)first << 32) | second] = amount;
+}
+
+int BitmapFont::getKerning(hkUint32 first, hkUint32 second) const
+{
+    auto it = _kernings.find(((hkUint64)first << 32) | second);
+    return it != _kernings.end() ? it->second : 0;
+}
+
+size_t BitmapFont::getMemoryUsage() const
+{
+    size_t bytes = sizeof(BitmapFont) + _glyphs.capacity() * sizeof(BMGlyph)
+        + MemoryStats::mapBytes(_astral) + MemoryStats::mapBytes(_kernings);
+    for (int i = 0; i < PAGE_SIZE; i++)
+    {
+        if (_pages[i] != nullptr)
+            bytes += sizeof(int) * PAGE_SIZE;
+    }
+    return bytes;
 }
 
 int BitmapFont::getCharacterIndexAtPos(const char * szText, const TextFormat & format, float fHorizPos, int iCharCount)
@@ -21,19 +113,39 @@ int BitmapFont::getCharacterIndexAtPos(const char * szText, const TextFormat & f
     if (scaleEnabled)
         fHorizPos *= size / format.size;
 
+    const char* p = szText;
+    const char* end = szText + iCharCount;
+    const BMGlyph* prev = nullptr;
+    hkUint32 prevId = 0;
     float x = 0;
-    for (int i = 0; i < iCharCount; i++)
+    while (p < end)
     {
-        auto def = chars.find(szText[i]);
-        if (def == chars.cend())
-            continue;
+        const char* start = p;
+        hkUint32 c = decodeUTF8(p, end);
+        const BMGlyph* glyph = nullptr;
+        if (c != ' ')
+        {
+            glyph = getGlyph(c);
+            if (glyph == nullptr)
+                continue;
+        }
 
         if (x >= fHorizPos)
-            return i;
+            return (int)(start - szText);
 
         if (x != 0)
             x += format.letterSpacing;
-        x += def->second.advance;
+        if (glyph != nullptr)
+        {
+            if (prev != nullptr && prev->kerning)
+                x += getKerning(prevId, c);
+            x += glyph->advance;
+        }
+        else
+            x += size / 2;
+
+        prev = glyph;
+        prevId = c;
     }
     return iCharCount;
 }
@@ -45,28 +157,37 @@ bool BitmapFont::getTextDimension(const char * szText, const TextFormat & format
     if (iCharCount == 0)
         return true;
 
+    const char* p = szText;
+    const char* end = szText + iCharCount;
+    const BMGlyph* prev = nullptr;
+    hkUint32 prevId = 0;
     float w = 0;
     float h = 0;
-    for (int i = 0; i < iCharCount; i++)
+    while (p < end)
     {
-        char c = szText[i];
+        hkUint32 c = decodeUTF8(p, end);
         if (c == ' ')
         {
             if (w != 0)
                 w += format.letterSpacing;
             w += size / 2;
             h = MAX(size, h);
+            prev = nullptr;
         }
         else
         {
-            auto def = chars.find(c);
-            if (def == chars.cend())
+            const BMGlyph* glyph = getGlyph(c);
+            if (glyph == nullptr)
                 continue;
 
             if (w != 0)
                 w += format.letterSpacing;
-            w += def->second.advance;
-            h = MAX(def->second.lineHeight, h);
+            if (prev != nullptr && prev->kerning)
+                w += getKerning(prevId, c);
+            w += glyph->advance;
+            h = MAX(glyph->lineHeight, h);
+            prev = glyph;
+            prevId = c;
         }
     }
 
@@ -94,40 +215,57 @@ int BitmapFont::getLineHeight(const TextFormat & format)
 
 void BitmapFont::prepareGraphics(NGraphics & graphics, TextRenderElement & re)
 {
-    hkvStringView view(re.text.c_str());
-    float x = 0;
-    while(view.IsValid())
-    {
-        hkUint32 c = view.GetCharacter();
-        ++view;
+    const char* text = re.text.c_str();
+    const char* end = text + re.text.size();
 
-        VColorRef color = colorEnabled ? re.format->color : V_RGBA_WHITE;
+    //count the quads first, then write them straight into one block of the vertex buffer
+    int count = 0;
+    for (const char* p = text; p < end;)
+    {
+        hkUint32 c = decodeUTF8(p, end);
+        if (c != ' ' && getGlyph(c) != nullptr)
+            count++;
+    }
+    if (count == 0)
+        return;
 
+    Overlay2DVertex_t* vertices = graphics.addQuads(count);
+    VColorRef color = colorEnabled ? re.format->color : V_RGBA_WHITE;
+    float letterSpacing = re.format->letterSpacing;
+    const BMGlyph* prev = nullptr;
+    hkUint32 prevId = 0;
+    float x = 0;
+    VRectanglef rect;
+    for (const char* p = text; p < end;)
+    {
+        hkUint32 c = decodeUTF8(p, end);
         if (c == ' ')
         {
             if (x != 0)
-                x += re.format->letterSpacing;
+                x += letterSpacing;
             x += size / 2;
+            prev = nullptr;
+            continue;
         }
-        else
-        {
-            auto def = chars.find(c);
-            if (def == chars.cend())
-                continue;
 
-            const BMGlyph& bg = def->second;
-            if (x != 0)
-                x += re.format->letterSpacing;
+        const BMGlyph* glyph = getGlyph(c);
+        if (glyph == nullptr)
+            continue;
 
-            VRectanglef rect;
-            rect.m_vMin.set(re.pos.x + x + bg.offsetX, re.pos.y + bg.offsetY);
-            rect.m_vMax.set(rect.m_vMin.x + bg.width, rect.m_vMin.y + bg.height);
-            graphics.addQuad(rect, bg.uv, color);
+        if (x != 0)
+            x += letterSpacing;
+        if (prev != nullptr && prev->kerning)
+            x += getKerning(prevId, c);
 
-            x += bg.advance;
-        }
+        rect.m_vMin.set(re.pos.x + x + glyph->offsetX, re.pos.y + glyph->offsetY);
+        rect.m_vMax.set(rect.m_vMin.x + glyph->width, rect.m_vMin.y + glyph->height);
+        NGraphics::writeQuad(vertices, rect, glyph->uv, color);
+        vertices += 6;
+
+        x += glyph->advance;
+        prev = glyph;
+        prevId = c;
     }
 }
 
 NS_FGUI_END
-
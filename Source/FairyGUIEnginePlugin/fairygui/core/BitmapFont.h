@@ -30,16 +30,57 @@ public:
         int advance;
         int lineHeight;
         VRectanglef uv;
+        bool kerning;   //first character of at least one kerning pair
     };
-    std::unordered_map<hkUint32, BMGlyph> chars;
+
+    //Glyphs are looked up for every character that is measured or drawn, so they are kept
+    //in dense tables: a direct array for 0-255, 256 entry pages allocated on demand for the
+    //rest of the BMP, and a map only for the astral planes.
+    void addGlyph(hkUint32 charId, const BMGlyph& glyph);
+    const BMGlyph* getGlyph(hkUint32 charId) const;
+    int getGlyphCount() const { return (int)_glyphs.size(); }
+
+    void addKerning(hkUint32 first, hkUint32 second, int amount);
+    int getKerning(hkUint32 first, hkUint32 second) const;
+
+    size_t getMemoryUsage() const;
 
     int size;
     int lineHeight;
 
 protected:
     float scale;
+
+private:
+    static const int PAGE_SIZE = 256;
+
+    std::vector<BMGlyph> _glyphs;
+    int _latin[PAGE_SIZE];
+    int* _pages[PAGE_SIZE];
+    std::unordered_map<hkUint32, int> _astral;
+    std::unordered_map<hkUint64, int> _kernings;
 };
 
+inline const BitmapFont::BMGlyph* BitmapFont::getGlyph(hkUint32 charId) const
+{
+    //table entries are glyph index + 1, 0 is a missing glyph
+    int index;
+    if (charId < PAGE_SIZE)
+        index = _latin[charId];
+    else if (charId < 0x10000)
+    {
+        const int* page = _pages[charId >> 8];
+        index = page != nullptr ? page[charId & 0xFF] : 0;
+    }
+    else
+    {
+        auto it = _astral.find(charId);
+        index = it != _astral.end() ? it->second : 0;
+    }
+
+    return index != 0 ? &_glyphs[index - 1] : nullptr;
+}
+
 NS_FGUI_END
 
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "DeviceInputSource.h"
+#include "FGUIManager.h"
+
+NS_FGUI_BEGIN
+
+DeviceInputSource::DeviceInputSource() :
+    _multiTouchInput(nullptr),
+    _mouseInput(nullptr),
+    _mousePos(-1, -1),
+    _mouseDown(false),
+    _capsLockOn(false)
+{
+    for (int i = 0; i < 256; i++)
+        _keyStatus[i] = -1;
+
+    _mouseInput = static_cast<VMousePC*>(&VInputManager::GetMouse());
+    if (_mouseInput == nullptr)
+        _multiTouchInput = static_cast<IVMultiTouchInput*>(&VInputManager::GetInputDevice(INPUT_DEVICE_TOUCHSCREEN));
+}
+
+DeviceInputSource::~DeviceInputSource()
+{
+}
+
+void DeviceInputSource::poll(InputQueue * queue)
+{
+    float time = Vision::GetTimer()->GetTime();
+
+    if (_multiTouchInput != nullptr)
+        pollTouches(queue, time);
+    else
+        pollMouse(queue, time);
+#ifdef SUPPORTS_KEYBOARD
+    pollKeyboard(queue, time);
+#endif
+}
+
+void DeviceInputSource::pollMouse(InputQueue * queue, float time)
+{
+    if (!FGUIManager::GlobalManager().isShowCursor())
+        return;
+
+    InputRecord record;
+    record.time = time;
+    record.touchId = 0;
+    record.x = _mouseInput->GetRawControlValue(CT_MOUSE_ABS_X);
+    record.y = _mouseInput->GetRawControlValue(CT_MOUSE_ABS_Y);
+
+    if (record.x != _mousePos.x || record.y != _mousePos.y)
+    {
+        _mousePos.set(record.x, record.y);
+        record.type = InputRecord::POINTER_MOVE;
+        queue->push(record);
+    }
+
+    bool leftDown = _mouseInput->GetRawControlValue(CT_MOUSE_LEFT_BUTTON) != 0;
+    bool rightDown = _mouseInput->GetRawControlValue(CT_MOUSE_RIGHT_BUTTON) != 0;
+    bool middleDown = _mouseInput->GetRawControlValue(CT_MOUSE_MIDDLE_BUTTON) != 0;
+    if (leftDown || rightDown || middleDown)
+    {
+        if (!_mouseDown)
+        {
+            _mouseDown = true;
+            record.type = InputRecord::POINTER_DOWN;
+            record.button = middleDown ? 2 : (rightDown ? 1 : 0);
+            queue->push(record);
+        }
+    }
+    else if (_mouseDown)
+    {
+        _mouseDown = false;
+        record.type = InputRecord::POINTER_UP;
+        queue->push(record);
+    }
+
+    int wheelDelta = (int)_mouseInput->GetRawControlValue(CT_MOUSE_WHEEL);
+    if (wheelDelta != 0)
+    {
+        record.type = InputRecord::WHEEL;
+        record.value = -wheelDelta;
+        queue->push(record);
+    }
+}
+
+void DeviceInputSource::pollTouches(InputQueue * queue, float time)
+{
+    for (auto &it : _touchPoints)
+        it.active = false;
+
+    InputRecord record;
+    record.time = time;
+    for (int i = 0; i < _multiTouchInput->GetNumberOfTouchPoints(); ++i)
+    {
+        if (!_multiTouchInput->IsActiveTouch(i))
+            continue;
+
+        auto uTouch = _multiTouchInput->GetTouch(i);
+        hkvVec2 pos(uTouch.fXAbsolute, uTouch.fYAbsolute);
+        //0 is kept for the mouse
+        record.touchId = (short)(uTouch.iID + 1);
+        record.x = pos.x;
+        record.y = pos.y;
+
+        TouchPoint* tp = nullptr;
+        for (auto &it : _touchPoints)
+        {
+            if (it.id == uTouch.iID)
+            {
+                tp = &it;
+                break;
+            }
+        }
+
+        if (tp == nullptr)
+        {
+            TouchPoint newPoint;
+            newPoint.id = uTouch.iID;
+            newPoint.pos = pos;
+            newPoint.active = true;
+            _touchPoints.push_back(newPoint);
+
+            record.type = InputRecord::POINTER_DOWN;
+            queue->push(record);
+        }
+        else
+        {
+            tp->active = true;
+            if (tp->pos != pos)
+            {
+                tp->pos = pos;
+                record.type = InputRecord::POINTER_MOVE;
+                queue->push(record);
+            }
+        }
+    }
+
+    for (auto it = _touchPoints.begin(); it != _touchPoints.end();)
+    {
+        if (!it->active)
+        {
+            record.type = InputRecord::POINTER_UP;
+            record.touchId = (short)(it->id + 1);
+            record.x = it->pos.x;
+            record.y = it->pos.y;
+            queue->push(record);
+
+            it = _touchPoints.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void DeviceInputSource::pollKeyboard(InputQueue * queue, float time)
+{
+    int modifiers = 0;
+
+    if (VGLIsKeyPressed(VGLK_LSHIFT)) modifiers |= 4;
+    if (VGLIsKeyPressed(VGLK_RSHIFT)) modifiers |= 4;
+    if (VGLIsKeyPressed(VGLK_LCTRL)) modifiers |= 1;
+    if (VGLIsKeyPressed(VGLK_RCTRL)) modifiers |= 1;
+    if (VGLIsKeyPressed(VGLK_LALT)) modifiers |= 2;
+    if (VGLIsKeyPressed(VGLK_RALT)) modifiers |= 2;
+
+    InputRecord record;
+    record.type = InputRecord::KEY;
+    record.time = time;
+    record.modifiers = modifiers;
+    for (int i = 1; i < 255; i++)
+    {
+        if (!VGLIsKeyPressed(i))
+        {
+            _keyStatus[i] = -1;
+            continue;
+        }
+
+        //first repeat after 0.5s, then every 0.05s
+        float status = _keyStatus[i];
+        if (status < 0)
+            _keyStatus[i] = time + 0.5f;
+        else
+        {
+            if (time - status < 0)
+                continue;
+
+            _keyStatus[i] = time + 0.05f;
+        }
+
+        if (i == VGLK_CAPS)
+        {
+            _capsLockOn = !_capsLockOn;
+            continue;
+        }
+
+        record.value = i;
+        if (i >= 32 && i <= 126)
+        {
+            const VGLKey_t *pKeyTable = VGLGetKeyCharMap();
+            bool bCapital = (modifiers & 4) > 0;
+            if (_capsLockOn)
+                bCapital = !bCapital;
+            record.character = bCapital ? pKeyTable[i].m_chUpper : pKeyTable[i].m_chLower;
+        }
+        else
+            record.character = 0;
+        queue->push(record);
+    }
+}
+
+NS_FGUI_END
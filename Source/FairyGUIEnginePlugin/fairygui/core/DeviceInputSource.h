@@ -0,0 +1,43 @@
+#ifndef __DEVICEINPUTSOURCE_H__
+#define __DEVICEINPUTSOURCE_H__
+
+#include "FGUIMacros.h"
+#include "InputQueue.h"
+
+NS_FGUI_BEGIN
+
+//Turns the state of the Vision mouse, touch screen and keyboard into events. The
+//devices can only be polled, so everything queued in one frame carries the same time
+//and the order within a frame is move, buttons, wheel, then keys.
+class FGUI_IMPEXP DeviceInputSource : public IInputSource
+{
+public:
+    DeviceInputSource();
+    virtual ~DeviceInputSource();
+
+    virtual void poll(InputQueue* queue) override;
+
+private:
+    struct TouchPoint
+    {
+        int id;
+        hkvVec2 pos;
+        bool active;
+    };
+
+    void pollMouse(InputQueue* queue, float time);
+    void pollTouches(InputQueue* queue, float time);
+    void pollKeyboard(InputQueue* queue, float time);
+
+    IVMultiTouchInput* _multiTouchInput;
+    VMousePC* _mouseInput;
+    hkvVec2 _mousePos;
+    bool _mouseDown;
+    std::vector<TouchPoint> _touchPoints;
+    float _keyStatus[256];
+    bool _capsLockOn;
+};
+
+NS_FGUI_END
+
+#endif
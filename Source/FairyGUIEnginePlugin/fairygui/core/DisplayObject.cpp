@@ -3,6 +3,8 @@
 #include "FGUIManager.h"
 #include "RenderContext.h"
 #include "utils/ToolSet.h"
+#include "utils/MemoryStats.h"
+#include "utils/Profiler.h"
 
 NS_FGUI_BEGIN
 
@@ -50,7 +52,9 @@ DisplayObject::DisplayObject() :
     _opaque(false),
     _touchChildren(true),
     _clipRect(nullptr),
-    _hitArea(nullptr)
+    _hitArea(nullptr),
+    _worldBoundsVersion(0),
+    _cullable(false)
 {
 }
 
@@ -71,6 +75,8 @@ DisplayObject::~DisplayObject()
     CC_SAFE_DELETE(_clipRect);
 }
 
+unsigned int DisplayObject::_hitVersion = 1;
+
 bool DisplayObject::init()
 {
     return true;
@@ -80,12 +86,14 @@ void DisplayObject::setX(float value)
 {
     _position.x = value;
     _outlineChanged = true;
+    _hitVersion++;
 }
 
 void DisplayObject::setY(float value)
 {
     _position.y = value;
     _outlineChanged = true;
+    _hitVersion++;
 }
 
 void DisplayObject::setPosition(float xv, float yv)
@@ -93,6 +101,7 @@ void DisplayObject::setPosition(float xv, float yv)
     _position.x = xv;
     _position.y = yv;
     _outlineChanged = true;
+    _hitVersion++;
 }
 
 hkvVec2 DisplayObject::getLocation()const
@@ -168,12 +177,14 @@ void DisplayObject::onSizeChanged(bool widthChanged, bool heightChanged)
     if (_graphics != nullptr)
         _requireUpdateMesh = true;
     _outlineChanged = true;
+    _hitVersion++;
 }
 
 void DisplayObject::setScaleX(float value)
 {
     _scale.x = value;
     _outlineChanged = true;
+    _hitVersion++;
     applyPivot();
 }
 
@@ -181,6 +192,7 @@ void DisplayObject::setScaleY(float value)
 {
     _scale.y = value;
     _outlineChanged = true;
+    _hitVersion++;
     applyPivot();
 }
 
@@ -189,6 +201,7 @@ void DisplayObject::setScale(float xv, float yv)
     _scale.x = xv;
     _scale.y = yv;
     _outlineChanged = true;
+    _hitVersion++;
     applyPivot();
 }
 
@@ -197,6 +210,7 @@ void DisplayObject::setSkew(float xv, float yv)
     _skew.x = xv;
     _skew.y = yv;
     _outlineChanged = true;
+    _hitVersion++;
     applyPivot();
 }
 
@@ -210,6 +224,7 @@ void DisplayObject::setPivot(float xv, float yv)
     updatePivotOffset();
     _position += oldOffset - _pivotOffset + deltaPivot;
     _outlineChanged = true;
+    _hitVersion++;
 }
 
 void DisplayObject::updatePivotOffset()
@@ -249,19 +264,28 @@ void DisplayObject::setAlpha(float value)
 
 void DisplayObject::setVisible(bool value)
 {
-    _visible = value;
+    if (_visible != value)
+    {
+        _visible = value;
+        _hitVersion++;
+    }
 }
 
 void DisplayObject::setRotation(float value)
 {
     _rotation.z = value;
     _outlineChanged = true;
+    _hitVersion++;
     applyPivot();
 }
 
 void DisplayObject::setTouchable(bool value)
 {
-    _touchable = value;
+    if (_touchable != value)
+    {
+        _touchable = value;
+        _hitVersion++;
+    }
 }
 
 void DisplayObject::setGrayed(bool value)
@@ -367,7 +391,7 @@ DisplayObject* DisplayObject::hitTest(HitTestContext* context)
     }
     else
     {
-        if (_clipRect != nullptr && !_clipRect->IsInside(localPoint))
+        if (_clipRect != nullptr && !_clipRect->rect.IsInside(localPoint))
             return nullptr;
     }
 
@@ -478,6 +502,7 @@ DisplayObject* DisplayObject::addChildAt(DisplayObject* child, int index)
             _children.insert(index, child);
 
         child->release();
+        _hitVersion++;
 
         if (onStage())
         {
@@ -513,6 +538,7 @@ void DisplayObject::removeChildAt(int index)
 
     child->_parent = nullptr;
     _children.erase(index);
+    _hitVersion++;
 }
 
 void DisplayObject::removeChildren(int beginIndex, int endIndex)
@@ -561,6 +587,7 @@ void DisplayObject::setChildIndex(DisplayObject* child, int index)
     else
         _children.insert(index, child);
     child->release();
+    _hitVersion++;
 }
 
 void DisplayObject::swapChildren(DisplayObject* child1, DisplayObject* child2)
@@ -610,7 +637,7 @@ bool DisplayObject::isAncestorOf(const DisplayObject * obj) const
 const VRectanglef & DisplayObject::getClipRect() const
 {
     if (_clipRect)
-        return *_clipRect;
+        return _clipRect->rect;
     else
         return EMPTY_RECT;
 }
@@ -620,41 +647,119 @@ void DisplayObject::setClipRect(const VRectanglef& value)
     if (value.GetSizeX() > 0 && value.GetSizeY() > 0)
     {
         if (!_clipRect)
-            _clipRect = new VRectanglef();
-        *_clipRect = value;
+            _clipRect = new ClipRect();
+        _clipRect->rect = value;
+        _clipRect->worldVersion = 0; //matrix versions start at 1
     }
     else
     {
         CC_SAFE_DELETE(_clipRect);
     }
+    _hitVersion++;
+}
+
+VRectanglef DisplayObject::getDrawRect()
+{
+    if (_graphics == nullptr)
+        return _contentRect;
+    else
+        return ToolSet::unionRect(_contentRect, _graphics->getMeshBounds());
+}
+
+const VRectanglef & DisplayObject::getWorldBounds()
+{
+    VRectanglef drawRect = getDrawRect();
+    if (_worldBoundsVersion != _matrixVersion || drawRect.m_vMin != _drawRect.m_vMin || drawRect.m_vMax != _drawRect.m_vMax)
+    {
+        _worldBoundsVersion = _matrixVersion;
+        _drawRect = drawRect;
+
+        hkvMat4 mat;
+        mat.setIdentity();
+        _worldBounds = ToolSet::transformRect(_drawRect, _localToWorldMatrix, mat);
+    }
+    return _worldBounds;
+}
+
+const VRectanglef & DisplayObject::getWorldClipRect()
+{
+    if (_clipRect->worldVersion != _matrixVersion)
+    {
+        _clipRect->worldVersion = _matrixVersion;
+
+        hkvMat4 mat;
+        mat.setIdentity();
+        _clipRect->worldRect = ToolSet::transformRect(_clipRect->rect, _localToWorldMatrix, mat);
+    }
+    return _clipRect->worldRect;
 }
 
 void DisplayObject::update(float dt)
 {
     validateMatrix(false);
 
+    VRectanglef childBounds(0, 0, 0, 0);
+    bool cullable = true;
     for (auto &child : _children)
     {
         if (child->_visible)
+        {
             child->update(dt);
+            childBounds = ToolSet::unionRect(childBounds, child->_renderBounds);
+            cullable = cullable && child->_cullable;
+        }
+    }
+    if (_clipRect != nullptr)
+        childBounds = ToolSet::intersection(childBounds, getWorldClipRect());
+
+    //graphics without a size or drawn outside the clip rect give no bounds to cull by
+    const VRectanglef& bounds = getWorldBounds();
+    if (_graphics != nullptr && (_graphics->isIgnoreClipping() || _drawRect.GetSizeX() == 0 || _drawRect.GetSizeY() == 0))
+        cullable = false;
+
+    _renderBounds = ToolSet::unionRect(bounds, childBounds);
+    _cullable = cullable;
+}
+
+void DisplayObject::growRenderBounds()
+{
+    //content rebuilt by Stage after the update pass may draw further than the bounds taken then,
+    //they are widened up the tree until the next update makes them exact again
+    VRectanglef bounds = getWorldBounds();
+    for (DisplayObject* obj = this; obj != nullptr; obj = obj->_parent)
+    {
+        VRectanglef grown = ToolSet::unionRect(obj->_renderBounds, bounds);
+        if (grown.m_vMin == obj->_renderBounds.m_vMin && grown.m_vMax == obj->_renderBounds.m_vMax)
+            break;
+
+        obj->_renderBounds = grown;
+        bounds = grown;
+        if (obj->_parent != nullptr && obj->_parent->_clipRect != nullptr)
+            bounds = ToolSet::intersection(bounds, obj->_parent->getWorldClipRect());
     }
 }
 
+void DisplayObject::collectMemoryStats(MemoryStats & stats) const
+{
+    //children are left to the owner, which usually has its own entry for them
+    stats.add(MemoryStats::OBJECTS, sizeof(DisplayObject) + MemoryStats::stringBytes(name)
+        + _children.capacity() * sizeof(DisplayObject*));
+    if (_graphics != nullptr)
+        stats.add(MemoryStats::VERTEX_BUFFERS, sizeof(NGraphics) + _graphics->getMemoryUsage());
+    stats.add(MemoryStats::EVENT_LISTENERS, getListenerMemoryUsage());
+}
+
 void DisplayObject::onRender(RenderContext* context)
 {
     if (_graphics != nullptr)
         _graphics->render(context, _localToWorldMatrix, _matrixVersion, _alpha);
 
-    if (_clipRect != nullptr)
-    {
-        hkvMat4 mat;
-        mat.setIdentity();
-        context->enterClipping(ToolSet::transformRect(*_clipRect, _localToWorldMatrix, mat));
-    }
-
     int cnt = (int)_children.size();
     if (cnt > 0)
     {
+        if (_clipRect != nullptr)
+            context->enterClipping(getWorldClipRect());
+
         float savedAlpha = context->alpha;
         context->alpha *= _alpha;
         bool savedGrayed = context->grayed;
@@ -663,8 +768,22 @@ void DisplayObject::onRender(RenderContext* context)
         for (int i = 0; i < cnt; i++)
         {
             DisplayObject* child = _children.at(i);
-            if (child->_visible)
-                child->onRender(context);
+            if (!child->_visible)
+                continue;
+
+            if (context->clipped && child->_cullable)
+            {
+                const VRectanglef& bounds = child->_renderBounds;
+                const VRectanglef& clip = context->clipInfo.rect;
+                if (bounds.m_vMax.x <= clip.m_vMin.x || bounds.m_vMin.x >= clip.m_vMax.x
+                    || bounds.m_vMax.y <= clip.m_vMin.y || bounds.m_vMin.y >= clip.m_vMax.y)
+                {
+                    FGUI_PROFILE_COUNT(NODES_CULLED, 1);
+                    continue;
+                }
+            }
+
+            child->onRender(context);
         }
 
         if (_clipRect != nullptr)
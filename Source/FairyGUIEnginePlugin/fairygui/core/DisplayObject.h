@@ -10,6 +10,7 @@ NS_FGUI_BEGIN
 class RenderContext;
 class HitTestContext;
 class IHitTest;
+class MemoryStats;
 
 class FGUI_IMPEXP DisplayObject : public Node
 {
@@ -99,22 +100,26 @@ public:
     bool isAncestorOf(const DisplayObject* obj) const;
 
     bool isTouchChildren() const { return _touchChildren; }
-    void setTouchChildren(bool value) { _touchChildren = value; }
+    void setTouchChildren(bool value) { _touchChildren = value; _hitVersion++; }
 
     bool isOpaque() const { return _opaque; }
-    void setOpaque(bool value) { _opaque = value; }
+    void setOpaque(bool value) { _opaque = value; _hitVersion++; }
 
     const VRectanglef& getClipRect() const;
     void setClipRect(const VRectanglef& value);
 
     IHitTest* getHitArea() const { return _hitArea; }
-    void setHitArea(IHitTest* value) { _hitArea = value; }
+    void setHitArea(IHitTest* value) { _hitArea = value; _hitVersion++; }
     DisplayObject* hitTest(const hkvVec2& stagePoint, bool forTouch);
+    //changes with anything that may change what a hit test returns: transforms, sizes,
+    //visibility, touchability and the order of children
+    static unsigned int getHitVersion() { return _hitVersion; }
 
     virtual bool onStage() const override;
 
     virtual void update(float dt);
     virtual void onRender(RenderContext* context);
+    virtual void collectMemoryStats(MemoryStats& stats) const;
 
     std::string name;
 
@@ -126,10 +131,14 @@ protected:
     virtual bool init();
     virtual void onSizeChanged(bool widthChanged, bool heightChanged);
     virtual DisplayObject* hitTest(HitTestContext* context);
+    //the local area drawn by the object itself, wider than _contentRect when the content overflows it
+    virtual VRectanglef getDrawRect();
 
     DisplayObject* internalHitTest(HitTestContext* context);
     DisplayObject* internalHitTestMask(HitTestContext* context);
 
+    static unsigned int _hitVersion;
+
     DisplayObject* _parent;
     NGraphics* _graphics;
     hkvVec2 _position;
@@ -159,14 +168,34 @@ private:
     void updatePivotOffset();
     void applyPivot();
     void validateMatrix(bool checkParent);
-
-    VRectanglef* _clipRect;
+    const VRectanglef& getWorldBounds();
+    const VRectanglef& getWorldClipRect();
+    void growRenderBounds();
+
+    struct ClipRect
+    {
+        VRectanglef rect;
+        VRectanglef worldRect;
+        hkUint32 worldVersion;
+    };
+
+    ClipRect* _clipRect;
     IHitTest* _hitArea;
     hkUint32 _matrixVersion;
     hkUint32 _parentMatrixVersion;
+    //_drawRect in world space, for _worldBoundsVersion of the matrix
+    VRectanglef _drawRect;
+    VRectanglef _worldBounds;
+    hkUint32 _worldBoundsVersion;
+    //this and the visible children in world space as of the last update, onRender skips
+    //the subtree when it misses the clip rect unless it is not cullable
+    VRectanglef _renderBounds;
+    bool _cullable;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(DisplayObject);
+
+    friend class Stage;
 };
 
 NS_FGUI_END
@@ -0,0 +1,370 @@
+#include "DynamicAtlas.h"
+#include "NTexture.h"
+#include "UIConfig.h"
+
+NS_FGUI_BEGIN
+
+static const int PADDING = 1;
+
+static inline bool intersects(int x, int y, int width, int height, int x2, int y2, int width2, int height2)
+{
+    return x < x2 + width2 && x2 < x + width && y < y2 + height2 && y2 < y + height;
+}
+
+static inline bool contains(int x, int y, int width, int height, int x2, int y2, int width2, int height2)
+{
+    return x2 >= x && y2 >= y && x2 + width2 <= x + width && y2 + height2 <= y + height;
+}
+
+DynamicAtlas::DynamicAtlas() :
+    _pageSerial(0),
+    _packedCount(0),
+    _rejectedCount(0)
+{
+}
+
+DynamicAtlas::~DynamicAtlas()
+{
+    clear();
+}
+
+NTexture * DynamicAtlas::pack(const VColorRef * pixels, int width, int height)
+{
+    if (pixels == nullptr || width <= 0 || height <= 0)
+        return nullptr;
+
+    int paddedWidth = width + PADDING * 2;
+    int paddedHeight = height + PADDING * 2;
+    if (paddedWidth > UIConfig::dynamicAtlasPageSize || paddedHeight > UIConfig::dynamicAtlasPageSize)
+    {
+        _rejectedCount++;
+        return nullptr;
+    }
+
+    Page* page = nullptr;
+    Rect rect;
+    for (auto &it : _pages)
+    {
+        if (findPosition(it, paddedWidth, paddedHeight, rect))
+        {
+            page = it;
+            break;
+        }
+    }
+
+    if (page == nullptr)
+    {
+        //freed regions may have left the space in pieces that are too small on their own
+        for (auto &it : _pages)
+        {
+            if (!it->fragmented)
+                continue;
+
+            rebuildFreeRects(it);
+            if (findPosition(it, paddedWidth, paddedHeight, rect))
+            {
+                page = it;
+                break;
+            }
+        }
+    }
+
+    if (page == nullptr && (int)_pages.size() < UIConfig::dynamicAtlasMaxPages)
+    {
+        page = createPage();
+        if (page != nullptr && !findPosition(page, paddedWidth, paddedHeight, rect))
+            page = nullptr;
+    }
+
+    if (page == nullptr)
+    {
+        _rejectedCount++;
+        return nullptr;
+    }
+
+    place(page, rect);
+    upload(page, rect, pixels, width, height);
+
+    NTexture* texture = new NTexture(page->texture,
+        VRectanglef((float)(rect.x + PADDING), (float)(rect.y + PADDING), (float)(rect.x + PADDING + width), (float)(rect.y + PADDING + height)));
+
+    Region region;
+    region.page = page;
+    region.rect = rect;
+    _regions[texture] = region;
+    _packedCount++;
+
+    return texture;
+}
+
+void DynamicAtlas::free(NTexture * texture)
+{
+    auto it = _regions.find(texture);
+    if (it == _regions.end())
+        return;
+
+    Page* page = it->second.page;
+    const Rect& rect = it->second.rect;
+    for (auto it2 = page->usedRects.begin(); it2 != page->usedRects.end(); ++it2)
+    {
+        if (it2->x == rect.x && it2->y == rect.y)
+        {
+            *it2 = page->usedRects.back();
+            page->usedRects.pop_back();
+            break;
+        }
+    }
+    page->usedArea -= rect.width * rect.height;
+
+    if (page->usedRects.empty())
+    {
+        Rect whole = { 0, 0, page->size, page->size };
+        page->freeRects.clear();
+        page->freeRects.push_back(whole);
+        page->fragmented = false;
+    }
+    else
+    {
+        //the freed area overlaps no used rect, so it is a valid free rect as it is
+        page->freeRects.push_back(rect);
+        page->fragmented = true;
+    }
+
+    _regions.erase(it);
+}
+
+bool DynamicAtlas::isPage(NTexture * texture) const
+{
+    for (auto &it : _pages)
+    {
+        if (it->texture == texture)
+            return true;
+    }
+    return false;
+}
+
+void DynamicAtlas::compact()
+{
+    for (auto it = _pages.begin(); it != _pages.end();)
+    {
+        Page* page = *it;
+        //a page nobody draws from any more is released, unless it is the last one
+        if (page->usedRects.empty() && _pages.size() > 1 && page->texture->getReferenceCount() == 1)
+        {
+            page->texture->release();
+            delete page;
+            it = _pages.erase(it);
+            continue;
+        }
+
+        if (page->fragmented)
+            rebuildFreeRects(page);
+        ++it;
+    }
+}
+
+void DynamicAtlas::clear()
+{
+    //textures that are still alive keep their page texture, they are just no longer tracked
+    _regions.clear();
+
+    for (auto &it : _pages)
+    {
+        it->texture->release();
+        delete it;
+    }
+    _pages.clear();
+}
+
+int DynamicAtlas::getTotalBytes() const
+{
+    int bytes = 0;
+    for (auto &it : _pages)
+        bytes += it->size * it->size * 4;
+    return bytes;
+}
+
+float DynamicAtlas::getUtilization(int page) const
+{
+    if (page >= 0)
+    {
+        if (page >= (int)_pages.size())
+            return 0;
+
+        const Page* p = _pages[page];
+        return (float)p->usedArea / (p->size * p->size);
+    }
+
+    long long used = 0;
+    long long total = 0;
+    for (auto &it : _pages)
+    {
+        used += it->usedArea;
+        total += it->size * it->size;
+    }
+    return total > 0 ? (float)((double)used / total) : 0;
+}
+
+DynamicAtlas::Page * DynamicAtlas::createPage()
+{
+    int size = UIConfig::dynamicAtlasPageSize;
+
+    char name[48];
+    sprintf(name, "fairygui_dynamic_atlas_%d", ++_pageSerial);
+    VTextureObject* tex = Vision::TextureManager.Create2DTextureObject(name, size, size, 1, VTextureLoader::R8G8B8A8);
+    if (tex == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot create dynamic atlas page %dx%d", size, size);
+        return nullptr;
+    }
+
+    //the page is never cleared: only the inside of regions and their extruded border is ever sampled
+    Page* page = new Page();
+    page->texture = new NTexture(tex);
+    page->size = size;
+    page->usedArea = 0;
+    page->fragmented = false;
+    Rect whole = { 0, 0, size, size };
+    page->freeRects.push_back(whole);
+    _pages.push_back(page);
+
+    return page;
+}
+
+bool DynamicAtlas::findPosition(Page * page, int width, int height, Rect & result) const
+{
+    int bestShortSide = INT_MAX;
+    int bestLongSide = INT_MAX;
+    for (auto &it : page->freeRects)
+    {
+        if (it.width < width || it.height < height)
+            continue;
+
+        int leftoverX = it.width - width;
+        int leftoverY = it.height - height;
+        int shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+        int longSide = leftoverX < leftoverY ? leftoverY : leftoverX;
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+        {
+            result.x = it.x;
+            result.y = it.y;
+            result.width = width;
+            result.height = height;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    return bestShortSide != INT_MAX;
+}
+
+void DynamicAtlas::place(Page * page, const Rect & rect)
+{
+    splitFreeRects(page, rect);
+    pruneFreeRects(page);
+
+    page->usedRects.push_back(rect);
+    page->usedArea += rect.width * rect.height;
+}
+
+void DynamicAtlas::rebuildFreeRects(Page * page)
+{
+    Rect whole = { 0, 0, page->size, page->size };
+    page->freeRects.clear();
+    page->freeRects.push_back(whole);
+
+    for (auto &it : page->usedRects)
+    {
+        splitFreeRects(page, it);
+        pruneFreeRects(page);
+    }
+    page->fragmented = false;
+}
+
+void DynamicAtlas::splitFreeRects(Page * page, const Rect & used)
+{
+    _scratchRects.clear();
+    for (auto &it : page->freeRects)
+    {
+        if (!intersects(it.x, it.y, it.width, it.height, used.x, used.y, used.width, used.height))
+        {
+            _scratchRects.push_back(it);
+            continue;
+        }
+
+        //keep the maximal rects left, right, above and below the used one
+        if (used.x > it.x)
+        {
+            Rect r = { it.x, it.y, used.x - it.x, it.height };
+            _scratchRects.push_back(r);
+        }
+        if (used.x + used.width < it.x + it.width)
+        {
+            Rect r = { used.x + used.width, it.y, it.x + it.width - used.x - used.width, it.height };
+            _scratchRects.push_back(r);
+        }
+        if (used.y > it.y)
+        {
+            Rect r = { it.x, it.y, it.width, used.y - it.y };
+            _scratchRects.push_back(r);
+        }
+        if (used.y + used.height < it.y + it.height)
+        {
+            Rect r = { it.x, used.y + used.height, it.width, it.y + it.height - used.y - used.height };
+            _scratchRects.push_back(r);
+        }
+    }
+    page->freeRects.swap(_scratchRects);
+}
+
+void DynamicAtlas::pruneFreeRects(Page * page)
+{
+    std::vector<Rect>& rects = page->freeRects;
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        for (size_t j = i + 1; j < rects.size(); j++)
+        {
+            const Rect& a = rects[i];
+            const Rect& b = rects[j];
+            if (contains(b.x, b.y, b.width, b.height, a.x, a.y, a.width, a.height))
+            {
+                rects.erase(rects.begin() + i);
+                i--;
+                break;
+            }
+            if (contains(a.x, a.y, a.width, a.height, b.x, b.y, b.width, b.height))
+            {
+                rects.erase(rects.begin() + j);
+                j--;
+            }
+        }
+    }
+}
+
+void DynamicAtlas::upload(Page * page, const Rect & rect, const VColorRef * pixels, int width, int height)
+{
+    //the border repeats the edge pixels, so bilinear filtering at the edges never reads a neighbour
+    _uploadBuffer.resize(rect.width * rect.height);
+    VColorRef* dst = _uploadBuffer.data();
+    for (int y = 0; y < rect.height; y++)
+    {
+        int sy = y - PADDING;
+        if (sy < 0)
+            sy = 0;
+        else if (sy >= height)
+            sy = height - 1;
+        const VColorRef* src = pixels + sy * width;
+
+        for (int i = 0; i < PADDING; i++)
+            *dst++ = src[0];
+        memcpy(dst, src, width * sizeof(VColorRef));
+        dst += width;
+        for (int i = 0; i < PADDING; i++)
+            *dst++ = src[width - 1];
+    }
+
+    page->texture->getNativeTexture()->UpdateRect(0, rect.x, rect.y, rect.width, rect.height,
+        rect.width * sizeof(VColorRef), _uploadBuffer.data(), 0);
+}
+
+NS_FGUI_END
@@ -0,0 +1,82 @@
+#ifndef __DYNAMICATLAS_H__
+#define __DYNAMICATLAS_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+class NTexture;
+
+//Packs small runtime textures into shared pages, so that external images drawn next
+//to each other can be batched instead of costing a draw each. Pages are
+//UIConfig::dynamicAtlasPageSize square, regions are placed with MaxRects (best short
+//side fit) and get a one pixel extruded border against filtering bleed. A region is
+//given back with free(); compact() merges the free space left by freed regions and
+//drops empty pages.
+class FGUI_IMPEXP DynamicAtlas
+{
+public:
+    DynamicAtlas();
+    ~DynamicAtlas();
+
+    //Copies the pixels into a page and returns a sub-region texture of it, or nullptr
+    //when the image does not fit or UIConfig::dynamicAtlasMaxPages pages are full.
+    //The caller owns the returned texture and must call free() before releasing it.
+    NTexture* pack(const VColorRef* pixels, int width, int height);
+    void free(NTexture* texture);
+    bool isPacked(NTexture* texture) const { return _regions.find(texture) != _regions.end(); }
+    bool isPage(NTexture* texture) const;
+
+    void compact();
+    void clear();
+
+    int getPageCount() const { return (int)_pages.size(); }
+    int getRegionCount() const { return (int)_regions.size(); }
+    int getTotalBytes() const;
+    //used area of the page (or of all pages when page is -1), 0..1
+    float getUtilization(int page = -1) const;
+    int getPackedCount() const { return _packedCount; }
+    int getRejectedCount() const { return _rejectedCount; }
+
+private:
+    struct Rect
+    {
+        int x, y, width, height;
+    };
+
+    struct Page
+    {
+        NTexture* texture;
+        std::vector<Rect> freeRects;
+        std::vector<Rect> usedRects;
+        int size;
+        int usedArea;
+        bool fragmented;
+    };
+
+    struct Region
+    {
+        Page* page;
+        Rect rect;
+    };
+
+    Page* createPage();
+    bool findPosition(Page* page, int width, int height, Rect& result) const;
+    void place(Page* page, const Rect& rect);
+    void rebuildFreeRects(Page* page);
+    void splitFreeRects(Page* page, const Rect& used);
+    void pruneFreeRects(Page* page);
+    void upload(Page* page, const Rect& rect, const VColorRef* pixels, int width, int height);
+
+    std::vector<Page*> _pages;
+    std::unordered_map<NTexture*, Region> _regions;
+    std::vector<Rect> _scratchRects;
+    std::vector<VColorRef> _uploadBuffer;
+    int _pageSerial;
+    int _packedCount;
+    int _rejectedCount;
+};
+
+NS_FGUI_END
+
+#endif
@@ -37,8 +37,7 @@ void PixelHitTestData::load(ByteArray & ba)
     scale = 1.0f / ba.readByte();
     pixelsLength = ba.readInt();
     pixels = new unsigned char[pixelsLength];
-    for (size_t i = 0; i < pixelsLength; i++)
-        pixels[i] = ba.readByte();
+    ba.readBytes((char*)pixels, pixelsLength);
 }
 
 PixelHitTest::PixelHitTest(PixelHitTestData * data, int offsetX, int offsetY) :
@@ -1,20 +1,29 @@
 #include "Image.h"
 #include "NGraphics.h"
 #include "utils/ToolSet.h"
+#include "utils/Profiler.h"
+#include "FGUIManager.h"
 
 NS_FGUI_BEGIN
 
 static int gridTileIndice[] = { -1, 0, -1, 2, 4, 3, -1, 1, -1 };
-static float gridX[4];
-static float gridY[4];
-static float gridTexX[4];
-static float gridTexY[4];
+
+//more tiles than this are drawn enlarged, so a huge area can not make an unbounded mesh
+static const int MAX_TILE_COUNT = 1024;
+//sets the keys of tile strips in MeshCache apart from those of whole images
+static const int TILE_STRIP_KEY = 1 << 30;
+
+static inline bool spansTexture(float uvSize)
+{
+    return fabsf(fabsf(uvSize) - 1) < 0.0001f;
+}
 
 Image::Image() :
     _scale9Grid(nullptr),
     _scaleByTile(false),
     _tileGridIndice(0),
-    _flip(FlipType::NONE)
+    _flip(FlipType::NONE),
+    _parallelRebuild(true)
 {
     _touchDisabled = true;
     _graphics = new NGraphics();
@@ -113,23 +122,79 @@ void Image::setTileGridIndice(int value)
 void Image::update(float dt)
 {
     if (_requireUpdateMesh)
-        rebuild();
+    {
+        //inside Stage::update the rebuild is deferred and batched with the other images of the frame
+        if (!_parallelRebuild || !StageInst->queueRebuild(this))
+            rebuild();
+    }
 
     DisplayObject::update(dt);
 }
 
 void Image::rebuild()
+{
+    FGUI_PROFILE_ZONE("Image::rebuild");
+    if (beginRebuild())
+    {
+        buildMesh();
+        endRebuild();
+    }
+}
+
+void Image::getMeshKey(MeshKey& key) const
+{
+    //images with the same inputs produce the same vertices, share them
+    NTexture* texture = _graphics->getTexture();
+    key.texture = texture;
+    key.rect = _contentRect;
+    key.uvRect = texture->getUVRect();
+    if (_flip != FlipType::NONE)
+        ToolSet::flipRect(key.uvRect, _flip);
+    if (_scale9Grid != nullptr)
+        key.grid = *_scale9Grid;
+    key.flags = (_scaleByTile ? 1 : 0) | (_tileGridIndice << 1);
+    key.color = _color;
+}
+
+bool Image::usesTileStrips() const
+{
+    //a single quad repeats a whole texture, anything else tiles with strips from MeshCache
+    if (_scaleByTile)
+        return !_graphics->getTexture()->isRepeatable();
+    else
+        return _scale9Grid != nullptr && _tileGridIndice != 0;
+}
+
+bool Image::beginRebuild()
 {
     _requireUpdateMesh = false;
+    _tileStrips.clear();
     _graphics->clearMesh();
+    _graphics->setTextureWrap(false);
 
-    NTexture* texture = _graphics->getTexture();
-    if (texture == nullptr)
-        return;
+    if (_graphics->getTexture() == nullptr)
+        return false;
 
-    VRectanglef uvRect = texture->getUVRect();
-    if (_flip != FlipType::NONE)
-        ToolSet::flipRect(uvRect, _flip);
+    MeshKey key;
+    getMeshKey(key);
+    return !_graphics->useSharedMesh(key);
+}
+
+void Image::endRebuild()
+{
+    //an identical image in the same batch may have shared its mesh already
+    MeshKey key;
+    getMeshKey(key);
+    if (!_graphics->useSharedMesh(key))
+        _graphics->shareMesh(key);
+}
+
+void Image::buildMesh()
+{
+    NTexture* texture = _graphics->getTexture();
+    MeshKey key;
+    getMeshKey(key);
+    const VRectanglef& uvRect = key.uvRect;
 
     /*if (_fillMethod != FillMethod.None)
     {
@@ -150,10 +215,12 @@ void Image::rebuild()
     }
     else if (_scale9Grid != nullptr)
     {
+        VRectanglef gridRect = *_scale9Grid;
         if (_flip != FlipType::NONE)
-            ToolSet::flipInnerRect((float)texture->getWidth(), (float)texture->getHeight(), *_scale9Grid, _flip);
+            ToolSet::flipInnerRect((float)texture->getWidth(), (float)texture->getHeight(), gridRect, _flip);
 
-        generateGrids(*_scale9Grid, uvRect);
+        GridPoints grid;
+        generateGrids(gridRect, uvRect, grid);
 
         if (_tileGridIndice == 0)
         {
@@ -162,8 +229,8 @@ void Image::rebuild()
                 int col = i % 3;
                 int row = i / 3;
 
-                _graphics->addQuad(VRectanglef(gridX[col], gridY[row], gridX[col + 1], gridY[row + 1]),
-                    VRectanglef(gridTexX[col], gridTexY[row], gridTexX[col + 1], gridTexY[row + 1]),
+                _graphics->addQuad(VRectanglef(grid.x[col], grid.y[row], grid.x[col + 1], grid.y[row + 1]),
+                    VRectanglef(grid.texX[col], grid.texY[row], grid.texX[col + 1], grid.texY[row + 1]),
                     _color);
             }
         }
@@ -179,8 +246,8 @@ void Image::rebuild()
                 col = pi % 3;
                 row = pi / 3;
                 part = gridTileIndice[pi];
-                drawRect.Set(gridX[col], gridY[row], gridX[col + 1], gridY[row + 1]);
-                texRect.Set(gridTexX[col], gridTexY[row], gridTexX[col + 1], gridTexY[row + 1]);
+                drawRect.Set(grid.x[col], grid.y[row], grid.x[col + 1], grid.y[row + 1]);
+                texRect.Set(grid.texX[col], grid.texY[row], grid.texX[col + 1], grid.texY[row + 1]);
 
                 if (part != -1 && (_tileGridIndice & (1 << part)) != 0)
                 {
@@ -208,69 +275,121 @@ void Image::tileFill(const VRectanglef& destRect, const VRectanglef& uvRect, flo
 {
     int hc = (int)hkvMath::ceil(destRect.GetSizeX() / sourceW);
     int vc = (int)hkvMath::ceil(destRect.GetSizeY() / sourceH);
-    float tailWidth = destRect.GetSizeX() - (hc - 1) * sourceW;
-    float tailHeight = destRect.GetSizeY() - (vc - 1) * sourceH;
 
-    for (int i = 0; i < hc; i++)
+    //The sampler repeats only a whole texture. When the uv covers it on every axis that has
+    //more than one tile, one quad whose uv runs past 1 draws all of them.
+    NTexture* texture = _graphics->getTexture();
+    if (texture->isRepeatable() && (hc <= 1 || spansTexture(uvRect.GetSizeX())) && (vc <= 1 || spansTexture(uvRect.GetSizeY())))
+    {
+        VRectanglef uvTmp = uvRect;
+        uvTmp.m_vMax.x = uvRect.m_vMin.x + uvRect.GetSizeX() * destRect.GetSizeX() / sourceW;
+        uvTmp.m_vMax.y = uvRect.m_vMin.y + uvRect.GetSizeY() * destRect.GetSizeY() / sourceH;
+        _graphics->addQuad(destRect, uvTmp, _color);
+        _graphics->setTextureWrap(true);
+        return;
+    }
+
+    while (hc * vc > MAX_TILE_COUNT)
+    {
+        float scale = sqrtf((float)hc * vc / MAX_TILE_COUNT);
+        sourceW *= scale;
+        sourceH *= scale;
+        hc = (int)hkvMath::ceil(destRect.GetSizeX() / sourceW);
+        vc = (int)hkvMath::ceil(destRect.GetSizeY() / sourceH);
+    }
+
+    //The quads are built once at the origin for a sprite and tile layout, and shared through
+    //MeshCache by every image and grid part that tiles the same way.
+    MeshKey key;
+    key.texture = texture;
+    key.rect.Set(0, 0, destRect.GetSizeX(), destRect.GetSizeY());
+    key.uvRect = uvRect;
+    key.grid.Set(sourceW, sourceH, (float)hc, (float)vc);
+    key.flags = TILE_STRIP_KEY;
+    key.color = _color;
+    SharedMesh* strip = MeshCache::get(key);
+    if (strip == nullptr)
     {
-        for (int j = 0; j < vc; j++)
+        float tailWidth = destRect.GetSizeX() - (hc - 1) * sourceW;
+        float tailHeight = destRect.GetSizeY() - (vc - 1) * sourceH;
+
+        hkvArray<Overlay2DVertex_t> vertices;
+        vertices.SetSize(hc * vc * 6);
+        Overlay2DVertex_t* dest = vertices.GetDataPointer();
+        for (int i = 0; i < hc; i++)
         {
-            VRectanglef uvTmp = uvRect;
-            if (i == hc - 1)
-                uvTmp.m_vMax.x = VLerp<float>()(uvRect.m_vMin.x, uvRect.m_vMax.x, tailWidth / sourceW);
-            if (j == vc - 1)
-                uvTmp.m_vMax.y = VLerp<float>()(uvRect.m_vMin.y, uvRect.m_vMax.y, tailHeight / sourceH);
-            float x = destRect.m_vMin.x + i * sourceW;
-            float y = destRect.m_vMin.y + j * sourceH;
-            _graphics->addQuad(VRectanglef(x, y, x + (i == (hc - 1) ? tailWidth : sourceW), y + (j == (vc - 1) ? tailHeight : sourceH)), uvTmp, _color);
+            for (int j = 0; j < vc; j++)
+            {
+                VRectanglef uvTmp = uvRect;
+                if (i == hc - 1)
+                    uvTmp.m_vMax.x = VLerp<float>()(uvRect.m_vMin.x, uvRect.m_vMax.x, tailWidth / sourceW);
+                if (j == vc - 1)
+                    uvTmp.m_vMax.y = VLerp<float>()(uvRect.m_vMin.y, uvRect.m_vMax.y, tailHeight / sourceH);
+                float x = i * sourceW;
+                float y = j * sourceH;
+                NGraphics::writeQuad(dest, VRectanglef(x, y, x + (i == (hc - 1) ? tailWidth : sourceW), y + (j == (vc - 1) ? tailHeight : sourceH)), uvTmp, _color);
+                dest += 6;
+            }
         }
+        strip = MeshCache::add(key, vertices, false);
+    }
+    _tileStrips.push_back(strip);
+
+    const hkvArray<Overlay2DVertex_t>& src = strip->getVertices();
+    int cnt = src.GetSize();
+    Overlay2DVertex_t* dest = _graphics->addQuads(cnt / 6);
+    for (int i = 0; i < cnt; i++)
+    {
+        dest[i] = src[i];
+        dest[i].screenPos.x += destRect.m_vMin.x;
+        dest[i].screenPos.y += destRect.m_vMin.y;
     }
 }
 
-void Image::generateGrids(const VRectanglef& gridRect, const VRectanglef& uvRect)
+void Image::generateGrids(const VRectanglef& gridRect, const VRectanglef& uvRect, GridPoints& grid)
 {
     NTexture* texture = _graphics->getTexture();
     float sx = uvRect.GetSizeX() / (float)texture->getWidth();
     float sy = uvRect.GetSizeY() / (float)texture->getHeight();
-    gridTexX[0] = uvRect.m_vMin.x;
-    gridTexX[1] = uvRect.m_vMin.x + gridRect.m_vMin.x * sx;
-    gridTexX[2] = uvRect.m_vMin.x + gridRect.m_vMax.x * sx;
-    gridTexX[3] = uvRect.m_vMax.x;
-    gridTexY[0] = uvRect.m_vMin.y;
-    gridTexY[1] = uvRect.m_vMin.y + gridRect.m_vMin.y * sy;
-    gridTexY[2] = uvRect.m_vMin.y + gridRect.m_vMax.y * sy;
-    gridTexY[3] = uvRect.m_vMax.y;
-
-    gridX[0] = 0;
-    gridY[0] = 0;
+    grid.texX[0] = uvRect.m_vMin.x;
+    grid.texX[1] = uvRect.m_vMin.x + gridRect.m_vMin.x * sx;
+    grid.texX[2] = uvRect.m_vMin.x + gridRect.m_vMax.x * sx;
+    grid.texX[3] = uvRect.m_vMax.x;
+    grid.texY[0] = uvRect.m_vMin.y;
+    grid.texY[1] = uvRect.m_vMin.y + gridRect.m_vMin.y * sy;
+    grid.texY[2] = uvRect.m_vMin.y + gridRect.m_vMax.y * sy;
+    grid.texY[3] = uvRect.m_vMax.y;
+
+    grid.x[0] = 0;
+    grid.y[0] = 0;
     if (_contentRect.GetSizeX() >= (texture->getWidth() - gridRect.GetSizeX()))
     {
-        gridX[1] = gridRect.m_vMin.x;
-        gridX[2] = _contentRect.GetSizeX() - (texture->getWidth() - gridRect.m_vMax.x);
-        gridX[3] = _contentRect.GetSizeX();
+        grid.x[1] = gridRect.m_vMin.x;
+        grid.x[2] = _contentRect.GetSizeX() - (texture->getWidth() - gridRect.m_vMax.x);
+        grid.x[3] = _contentRect.GetSizeX();
     }
     else
     {
         float tmp = gridRect.m_vMin.x / (texture->getWidth() - gridRect.m_vMax.x);
         tmp = _contentRect.GetSizeX() * tmp / (1 + tmp);
-        gridX[1] = tmp;
-        gridX[2] = tmp;
-        gridX[3] = _contentRect.GetSizeX();
+        grid.x[1] = tmp;
+        grid.x[2] = tmp;
+        grid.x[3] = _contentRect.GetSizeX();
     }
 
     if (_contentRect.GetSizeY() >= (texture->getHeight() - gridRect.GetSizeY()))
     {
-        gridY[1] = gridRect.m_vMin.y;
-        gridY[2] = _contentRect.GetSizeY() - (texture->getHeight() - gridRect.m_vMax.y);
-        gridY[3] = _contentRect.GetSizeY();
+        grid.y[1] = gridRect.m_vMin.y;
+        grid.y[2] = _contentRect.GetSizeY() - (texture->getHeight() - gridRect.m_vMax.y);
+        grid.y[3] = _contentRect.GetSizeY();
     }
     else
     {
         float tmp = gridRect.m_vMin.y / (texture->getHeight() - gridRect.m_vMax.y);
         tmp = _contentRect.GetSizeY() * tmp / (1 + tmp);
-        gridY[1] = tmp;
-        gridY[2] = tmp;
-        gridY[3] = _contentRect.GetSizeY();
+        grid.y[1] = tmp;
+        grid.y[2] = tmp;
+        grid.y[3] = _contentRect.GetSizeY();
     }
 }
 
@@ -40,19 +40,41 @@ protected:
     virtual ~Image();
 
 protected:
+    struct GridPoints
+    {
+        float x[4];
+        float y[4];
+        float texX[4];
+        float texY[4];
+    };
+
     virtual void rebuild();
 
+    //rebuild in three steps for Stage::flushRebuilds. Only buildMesh may run on a worker
+    //thread, it reads the image state and writes nothing but the vertices of _graphics.
+    //Images that usesTileStrips() look up MeshCache in buildMesh and stay on the main thread.
+    bool usesTileStrips() const;
+    bool beginRebuild();
+    void buildMesh();
+    void endRebuild();
+    void getMeshKey(MeshKey& key) const;
+
     void tileFill(const VRectanglef& destRect, const VRectanglef& uvRect, float sourceW, float sourceH);
-    void generateGrids(const VRectanglef& gridRect, const VRectanglef& uvRect);
+    void generateGrids(const VRectanglef& gridRect, const VRectanglef& uvRect, GridPoints& grid);
 
     VColorRef _color;
     VRectanglef* _scale9Grid;
     bool _scaleByTile;
     int _tileGridIndice;
     FlipType _flip;
+    bool _parallelRebuild;
+    //holds the strips tileFill copied, so they stay in MeshCache for images tiling the same way
+    std::vector<RefPtr<SharedMesh>> _tileStrips;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Image);
+
+    friend class Stage;
 };
 
 NS_FGUI_END
@@ -0,0 +1,39 @@
+#include "InputQueue.h"
+
+NS_FGUI_BEGIN
+
+InputRecord::InputRecord() :
+    type(POINTER_MOVE),
+    button(0),
+    touchId(0),
+    time(0),
+    x(0),
+    y(0),
+    value(0),
+    character(0),
+    modifiers(0)
+{
+}
+
+InputQueue::InputQueue() :
+    _coalescedCount(0)
+{
+}
+
+void InputQueue::push(const InputRecord & record)
+{
+    if (record.type == InputRecord::POINTER_MOVE && !_records.empty())
+    {
+        InputRecord& last = _records.back();
+        if (last.type == InputRecord::POINTER_MOVE && last.touchId == record.touchId)
+        {
+            last = record;
+            _coalescedCount++;
+            return;
+        }
+    }
+
+    _records.push_back(record);
+}
+
+NS_FGUI_END
@@ -0,0 +1,67 @@
+#ifndef __INPUTQUEUE_H__
+#define __INPUTQUEUE_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+//One input event as it is queued for the stage, and as it is recorded and replayed.
+struct InputRecord
+{
+    enum Type
+    {
+        POINTER_MOVE,
+        POINTER_DOWN,
+        POINTER_UP,
+        WHEEL,
+        KEY,
+        TEXT
+    };
+
+    unsigned char type;
+    unsigned char button; //0-left, 1-right, 2-middle
+    short touchId; //0 is the mouse
+    float time; //seconds, double clicks are timed with it
+    float x;
+    float y;
+    int value; //WHEEL: delta, KEY: key code
+    int character; //KEY, TEXT: the character typed, 0 for none
+    int modifiers; //1-ctrl, 2-alt, 4-shift
+
+    InputRecord();
+};
+
+//The events of one frame in the order they happened. Stage processes them all in its
+//next update, each with its own hit test.
+class FGUI_IMPEXP InputQueue
+{
+public:
+    InputQueue();
+
+    //a move directly following a move of the same pointer replaces it
+    void push(const InputRecord& record);
+    void clear() { _records.clear(); }
+    //moves the events to records and leaves the queue empty
+    void drain(std::vector<InputRecord>& records) { records.clear(); records.swap(_records); }
+    bool isEmpty() const { return _records.empty(); }
+    const std::vector<InputRecord>& getRecords() const { return _records; }
+
+    int getCoalescedCount() const { return _coalescedCount; }
+
+private:
+    std::vector<InputRecord> _records;
+    int _coalescedCount;
+};
+
+class FGUI_IMPEXP IInputSource
+{
+public:
+    virtual ~IInputSource() {}
+
+    //called at the start of every Stage update to queue what happened since the last call
+    virtual void poll(InputQueue* queue) = 0;
+};
+
+NS_FGUI_END
+
+#endif
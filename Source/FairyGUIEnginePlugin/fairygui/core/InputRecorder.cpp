@@ -0,0 +1,176 @@
+#include "InputRecorder.h"
+
+NS_FGUI_BEGIN
+
+static const char MAGIC[4] = { 'F', 'G', 'I', 'R' };
+static const int VERSION = 1;
+static const size_t RECORD_SIZE = 28;
+
+template<typename T>
+static void writeValue(std::vector<char>& buffer, T value)
+{
+    //the format is little endian, like every target of the engine
+    const char* p = (const char*)&value;
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+template<typename T>
+static T readValue(const char*& p)
+{
+    T value;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+InputRecorder::InputRecorder() :
+    _stream(nullptr),
+    _frameCount(0),
+    _eventCount(0)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+    stop();
+}
+
+bool InputRecorder::start(const std::string & filePath)
+{
+    stop();
+
+    _stream = VFileAccessManager::GetInstance()->Create(filePath.c_str());
+    if (_stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot write input recording to '%s'", filePath.c_str());
+        return false;
+    }
+
+    _frameCount = 0;
+    _eventCount = 0;
+    _buffer.clear();
+    _buffer.insert(_buffer.end(), MAGIC, MAGIC + 4);
+    writeValue<int>(_buffer, VERSION);
+    _stream->Write(_buffer.data(), _buffer.size());
+    return true;
+}
+
+void InputRecorder::stop()
+{
+    if (_stream == nullptr)
+        return;
+
+    _stream->Close();
+    _stream = nullptr;
+}
+
+void InputRecorder::writeFrame(const std::vector<InputRecord>& records)
+{
+    if (_stream == nullptr)
+        return;
+
+    int frame = _frameCount++;
+    if (records.empty())
+        return;
+
+    _buffer.clear();
+    writeValue<int>(_buffer, frame);
+    writeValue<int>(_buffer, (int)records.size());
+    for (auto &it : records)
+    {
+        writeValue<unsigned char>(_buffer, it.type);
+        writeValue<unsigned char>(_buffer, it.button);
+        writeValue<short>(_buffer, it.touchId);
+        writeValue<float>(_buffer, it.time);
+        writeValue<float>(_buffer, it.x);
+        writeValue<float>(_buffer, it.y);
+        writeValue<int>(_buffer, it.value);
+        writeValue<int>(_buffer, it.character);
+        writeValue<int>(_buffer, it.modifiers);
+    }
+    _stream->Write(_buffer.data(), _buffer.size());
+    _eventCount += (int)records.size();
+}
+
+InputPlayer::InputPlayer() :
+    _next(0),
+    _frameCount(0)
+{
+}
+
+InputPlayer::~InputPlayer()
+{
+}
+
+bool InputPlayer::load(const std::string & filePath)
+{
+    _records.clear();
+    _frames.clear();
+    rewind();
+
+    IVFileInStream* stream = VFileAccessManager::GetInstance()->Open(filePath.c_str());
+    if (stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot open input recording '%s'", filePath.c_str());
+        return false;
+    }
+
+    std::vector<char> data(stream->GetSize());
+    size_t len = data.empty() ? 0 : stream->Read(data.data(), data.size());
+    stream->Close();
+
+    const char* p = data.data();
+    const char* end = p + len;
+    if (len < 8 || memcmp(p, MAGIC, 4) != 0)
+    {
+        CCLOGWARN("FairyGUI: '%s' is not an input recording", filePath.c_str());
+        return false;
+    }
+    p += 4;
+    if (readValue<int>(p) != VERSION)
+    {
+        CCLOGWARN("FairyGUI: unsupported input recording version in '%s'", filePath.c_str());
+        return false;
+    }
+
+    while (end - p >= 8)
+    {
+        int frame = readValue<int>(p);
+        int cnt = readValue<int>(p);
+        if (cnt < 0 || (size_t)(end - p) < cnt * RECORD_SIZE)
+            break;
+
+        for (int i = 0; i < cnt; i++)
+        {
+            InputRecord record;
+            record.type = readValue<unsigned char>(p);
+            record.button = readValue<unsigned char>(p);
+            record.touchId = readValue<short>(p);
+            record.time = readValue<float>(p);
+            record.x = readValue<float>(p);
+            record.y = readValue<float>(p);
+            record.value = readValue<int>(p);
+            record.character = readValue<int>(p);
+            record.modifiers = readValue<int>(p);
+            _records.push_back(record);
+            _frames.push_back(frame);
+        }
+    }
+
+    return true;
+}
+
+void InputPlayer::rewind()
+{
+    _next = 0;
+    _frameCount = 0;
+}
+
+void InputPlayer::poll(InputQueue * queue)
+{
+    int frame = _frameCount++;
+    while (_next < _records.size() && _frames[_next] <= frame)
+        queue->push(_records[_next++]);
+}
+
+NS_FGUI_END
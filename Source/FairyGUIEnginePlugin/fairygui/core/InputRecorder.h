@@ -0,0 +1,58 @@
+#ifndef __INPUTRECORDER_H__
+#define __INPUTRECORDER_H__
+
+#include "FGUIMacros.h"
+#include "InputQueue.h"
+
+NS_FGUI_BEGIN
+
+//Writes the events the stage processes to a binary file, grouped by frame:
+//"FGIR", version, then for every frame with events its index, the event count
+//and the events, 28 bytes each, little endian.
+class FGUI_IMPEXP InputRecorder
+{
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool start(const std::string& filePath);
+    void stop();
+    bool isRecording() const { return _stream != nullptr; }
+
+    void writeFrame(const std::vector<InputRecord>& records);
+
+    int getFrameCount() const { return _frameCount; }
+    int getEventCount() const { return _eventCount; }
+
+private:
+    IVFileOutStream* _stream;
+    std::vector<char> _buffer;
+    int _frameCount;
+    int _eventCount;
+};
+
+//Replays a file written by InputRecorder. Events are given back frame by frame
+//instead of by their time, so the session plays the same however fast frames are
+//run, e.g. headless as a repeatable benchmark scenario.
+class FGUI_IMPEXP InputPlayer : public IInputSource
+{
+public:
+    InputPlayer();
+    virtual ~InputPlayer();
+
+    bool load(const std::string& filePath);
+    void rewind();
+    bool isFinished() const { return _next >= _records.size(); }
+
+    virtual void poll(InputQueue* queue) override;
+
+private:
+    std::vector<InputRecord> _records;
+    std::vector<int> _frames;
+    size_t _next;
+    int _frameCount;
+};
+
+NS_FGUI_END
+
+#endif
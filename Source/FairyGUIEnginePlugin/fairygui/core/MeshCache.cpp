@@ -0,0 +1,95 @@
+#include "MeshCache.h"
+
+NS_FGUI_BEGIN
+
+std::unordered_map<MeshKey, SharedMesh*, MeshKeyHash> MeshCache::_meshes;
+
+static inline void hashCombine(size_t& seed, float value)
+{
+    //-0.0 compares equal to 0.0 but has other bits
+    if (value == 0)
+        value = 0;
+    seed ^= std::hash<float>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static inline void hashCombine(size_t& seed, const VRectanglef& rect)
+{
+    hashCombine(seed, rect.m_vMin.x);
+    hashCombine(seed, rect.m_vMin.y);
+    hashCombine(seed, rect.m_vMax.x);
+    hashCombine(seed, rect.m_vMax.y);
+}
+
+static inline bool rectEquals(const VRectanglef& a, const VRectanglef& b)
+{
+    return a.m_vMin.x == b.m_vMin.x && a.m_vMin.y == b.m_vMin.y
+        && a.m_vMax.x == b.m_vMax.x && a.m_vMax.y == b.m_vMax.y;
+}
+
+MeshKey::MeshKey() :
+    texture(nullptr),
+    rect(0, 0, 0, 0),
+    uvRect(0, 0, 0, 0),
+    grid(0, 0, 0, 0),
+    flags(0),
+    color(255, 255, 255, 255)
+{
+}
+
+bool MeshKey::operator==(const MeshKey & other) const
+{
+    return texture == other.texture && flags == other.flags && color == other.color
+        && rectEquals(rect, other.rect) && rectEquals(uvRect, other.uvRect) && rectEquals(grid, other.grid);
+}
+
+size_t MeshKeyHash::operator()(const MeshKey & key) const
+{
+    size_t seed = std::hash<void*>()(key.texture);
+    hashCombine(seed, key.rect);
+    hashCombine(seed, key.uvRect);
+    hashCombine(seed, key.grid);
+    seed ^= std::hash<int>()(key.flags) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int>()((key.color.r << 24) | (key.color.g << 16) | (key.color.b << 8) | key.color.a) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+SharedMesh::SharedMesh() :
+    _textureWrap(false)
+{
+}
+
+SharedMesh::~SharedMesh()
+{
+    MeshCache::remove(this);
+}
+
+SharedMesh * MeshCache::get(const MeshKey & key)
+{
+    auto it = _meshes.find(key);
+    if (it != _meshes.end())
+        return it->second;
+    else
+        return nullptr;
+}
+
+SharedMesh * MeshCache::add(const MeshKey & key, const hkvArray<Overlay2DVertex_t>& vertices, bool textureWrap)
+{
+    SharedMesh* mesh = new SharedMesh();
+    mesh->autorelease();
+    mesh->_key = key;
+    //the mesh keeps the texture alive, so the pointer in the key can not be reused by another texture
+    mesh->_texture = key.texture;
+    mesh->_vertices = vertices;
+    mesh->_textureWrap = textureWrap;
+    _meshes[key] = mesh;
+    return mesh;
+}
+
+void MeshCache::remove(SharedMesh * mesh)
+{
+    auto it = _meshes.find(mesh->_key);
+    if (it != _meshes.end() && it->second == mesh)
+        _meshes.erase(it);
+}
+
+NS_FGUI_END
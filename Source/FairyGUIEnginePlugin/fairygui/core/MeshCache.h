@@ -0,0 +1,65 @@
+#ifndef __MESHCACHE_H__
+#define __MESHCACHE_H__
+
+#include "FGUIMacros.h"
+#include "NTexture.h"
+
+NS_FGUI_BEGIN
+
+struct MeshKey
+{
+    NTexture* texture;
+    VRectanglef rect;
+    VRectanglef uvRect;
+    VRectanglef grid;
+    int flags;
+    VColorRef color;
+
+    MeshKey();
+    bool operator==(const MeshKey& other) const;
+};
+
+struct MeshKeyHash
+{
+    size_t operator()(const MeshKey& key) const;
+};
+
+//Local space vertices shared by every NGraphics built from the same MeshKey.
+//Must not be modified once it is in the cache.
+class FGUI_IMPEXP SharedMesh : public Ref
+{
+public:
+    virtual ~SharedMesh();
+
+    const hkvArray<Overlay2DVertex_t>& getVertices() const { return _vertices; }
+    bool isTextureWrap() const { return _textureWrap; }
+
+private:
+    SharedMesh();
+
+    MeshKey _key;
+    RefPtr<NTexture> _texture;
+    hkvArray<Overlay2DVertex_t> _vertices;
+    bool _textureWrap;
+
+    friend class MeshCache;
+};
+
+class FGUI_IMPEXP MeshCache
+{
+public:
+    static SharedMesh* get(const MeshKey& key);
+    static SharedMesh* add(const MeshKey& key, const hkvArray<Overlay2DVertex_t>& vertices, bool textureWrap);
+    static int getMeshCount() { return (int)_meshes.size(); }
+
+private:
+    static void remove(SharedMesh* mesh);
+
+    static std::unordered_map<MeshKey, SharedMesh*, MeshKeyHash> _meshes;
+
+    friend class SharedMesh;
+};
+
+NS_FGUI_END
+
+#endif
@@ -1,5 +1,6 @@
 #include "MovieClip.h"
 #include "FGUIManager.h"
+#include "MovieClipAnimator.h"
 #include "utils/ToolSet.h"
 
 NS_FGUI_BEGIN
@@ -28,7 +29,7 @@ void PlayState::update(MovieClip* mc, float dt)
 
     _reachEnding = false;
     _curFrameDelay += dt;
-    float interval = mc->_interval + mc->_frames[_currentFrame].addDelay + ((_currentFrame == 0 && _repeatedCount > 0) ? mc->_repeatDelay : 0);
+    float interval = mc->_interval + mc->_frames->items[_currentFrame].addDelay + ((_currentFrame == 0 && _repeatedCount > 0) ? mc->_repeatDelay : 0);
     if (_curFrameDelay < interval)
         return;
 
@@ -94,6 +95,8 @@ MovieClip::MovieClip() :
     _swing(false),
     _repeatDelay(0),
     _frameCount(0),
+    _frames(nullptr),
+    _framesRect(0, 0, 0, 0),
     _currentFrame(0),
     _playing(true),
     _start(0),
@@ -101,23 +104,40 @@ MovieClip::MovieClip() :
     _times(0),
     _endAt(0),
     _status(0),
-    _forceDraw(false)
+    _forceDraw(false),
+    _framePending(false),
+    _updateFrameId(0),
+    _animatorIndex(-1)
 {
     _playState = new PlayState();
     setPlaySettings();
+    //frames are drawn by drawFrame, which is not split into the batched steps
+    _parallelRebuild = false;
+
+    MovieClipAnimator* animator = FGUIManager::GlobalManager().getMovieClipAnimator();
+    if (animator != nullptr)
+        animator->add(this);
 }
 
 MovieClip::~MovieClip()
 {
+    MovieClipAnimator* animator = FGUIManager::GlobalManager().getMovieClipAnimator();
+    if (animator != nullptr)
+        animator->remove(this);
     CC_SAFE_RELEASE(_playState);
+    CC_SAFE_RELEASE(_frames);
 }
 
-void MovieClip::setData(NTexture* texture, const hkvArray<Frame>& frames, const VRectanglef& boundsRect)
+void MovieClip::setData(NTexture* texture, Frames* frames, const VRectanglef& boundsRect)
 {
-    _frames.Clear();
-    _frames.PushBackRange(frames);
-    _frameCount = frames.GetSize();
+    CC_SAFE_RETAIN(frames);
+    CC_SAFE_RELEASE(_frames);
+    _frames = frames;
+    _frameCount = frames != nullptr ? frames->items.GetSize() : 0;
     _contentRect = boundsRect;
+    _framesRect = VRectanglef(0, 0, 0, 0);
+    for (int i = 0; i < _frameCount; i++)
+        _framesRect = ToolSet::unionRect(_framesRect, frames->items[i].rect);
 
     if (_end == -1 || _end > _frameCount - 1)
         _end = _frameCount - 1;
@@ -134,9 +154,16 @@ void MovieClip::setData(NTexture* texture, const hkvArray<Frame>& frames, const
     _completeCallback = nullptr;
 }
 
+VRectanglef MovieClip::getDrawRect()
+{
+    return ToolSet::unionRect(Image::getDrawRect(), _framesRect);
+}
+
 void MovieClip::clear()
 {
     _frameCount = 0;
+    _framesRect = VRectanglef(0, 0, 0, 0);
+    CC_SAFE_RELEASE_NULL(_frames);
     _completeCallback = nullptr;
     setTexture(nullptr);
     _graphics->clearMesh();
@@ -175,12 +202,11 @@ void MovieClip::setPlaySettings(int start, int end, int times, int endAt, std::f
 
 void MovieClip::drawFrame()
 {
-    _forceDraw = false;
-    _graphics->clearMesh();
+    _framePending = false;
 
     if (_currentFrame < _frameCount)
     {
-        const Frame& frame = _frames[_currentFrame];
+        const Frame& frame = _frames->items[_currentFrame];
 
         if (frame.rect.GetSizeX() > 0)
         {
@@ -188,20 +214,57 @@ void MovieClip::drawFrame()
             if (_flip != FlipType::NONE)
                 ToolSet::flipRect(uvRect, _flip);
 
+            if (_playing)
+            {
+                //a playing clip keeps its own quad and only moves its corners and uv
+                if (!_graphics->updateQuad(frame.rect, uvRect))
+                {
+                    _graphics->clearMesh();
+                    _graphics->addQuad(frame.rect, uvRect, _color);
+                }
+                if (frame.rotated)
+                    _graphics->rotateUV(uvRect);
+                return;
+            }
+
+            _graphics->clearMesh();
+
+            MeshKey key;
+            key.texture = _graphics->getTexture();
+            key.rect = frame.rect;
+            key.uvRect = uvRect;
+            key.flags = frame.rotated ? 1 : 0;
+            key.color = _color;
+            if (_graphics->useSharedMesh(key))
+                return;
+
             _graphics->addQuad(frame.rect, uvRect, _color);
             if (frame.rotated)
                 _graphics->rotateUV(uvRect);
+            _graphics->shareMesh(key);
+            return;
         }
     }
+
+    _graphics->clearMesh();
 }
 
 void MovieClip::update(float dt)
+{
+    //the frame is advanced later by MovieClipAnimator, which only needs to know the clip was reached
+    _updateFrameId = FGUIManager::GlobalManager().getFrameCount();
+
+    Image::update(dt);
+}
+
+void MovieClip::advance(float dt)
 {
     if (_playing && _frameCount != 0 && _status != 3)
     {
         _playState->update(this, dt);
         if (_forceDraw || _currentFrame != _playState->getCurrentFrame())
         {
+            _forceDraw = false;
             if (_status == 1)
             {
                 _currentFrame = _start;
@@ -234,13 +297,22 @@ void MovieClip::update(float dt)
                         _status = 1;
                 }
             }
-            drawFrame();
+            _framePending = true;
         }
     }
     else if (_forceDraw)
+    {
+        _forceDraw = false;
+        _framePending = true;
+    }
+}
+
+void MovieClip::onRender(RenderContext * context)
+{
+    if (_framePending)
         drawFrame();
 
-    Image::update(dt);
+    Image::onRender(context);
 }
 
 void MovieClip::playCompleted(float)
@@ -258,6 +330,8 @@ void MovieClip::rebuild()
     if (_frameCount > 0)
     {
         _requireUpdateMesh = false;
+        //color or flip may have changed, so the quad of a playing clip is not reused
+        _graphics->clearMesh();
         drawFrame();
     }
     else
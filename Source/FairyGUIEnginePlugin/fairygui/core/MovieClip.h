@@ -44,10 +44,17 @@ public:
         bool rotated;
     };
 
+    //the frames of a movieclip resource, built by UIPackage and shared by every clip showing it
+    class Frames : public Ref
+    {
+    public:
+        hkvArray<Frame> items;
+    };
+
     void setInterval(float value) { _interval = value; }
     void setSwing(bool value) { _swing = value; }
     void setRepeatDelay(float value) { _repeatDelay = value; }
-    void setData(NTexture* texture, const hkvArray<Frame>& frames, const VRectanglef& boundsRect);
+    void setData(NTexture* texture, Frames* frames, const VRectanglef& boundsRect);
     void clear();
     bool isPlaying() const { return _playing; }
     void setPlaying(bool value);
@@ -58,6 +65,7 @@ public:
     void drawFrame();
 
     virtual void update(float dt) override;
+    virtual void onRender(RenderContext* context) override;
 
 protected:
     MovieClip();
@@ -65,14 +73,18 @@ protected:
 
 protected:
     virtual void rebuild() override;
+    virtual VRectanglef getDrawRect() override;
 
+    void advance(float dt);
     void playCompleted(float);
 
     float _interval;
     bool _swing;
     float _repeatDelay;
     int _frameCount;
-    hkvArray<Frame> _frames;
+    Frames* _frames;
+    //all the frame rects, the frame is advanced after the update pass has taken the bounds
+    VRectanglef _framesRect;
     RefPtr<PlayState> _playState;
     std::function<void()> _completeCallback;
 
@@ -84,8 +96,12 @@ protected:
     int _endAt;
     int _status; //0-none, 1-next loop, 2-ending, 3-ended
     bool _forceDraw;
+    bool _framePending;
+    int _updateFrameId;
+    int _animatorIndex;
 
     friend class PlayState;
+    friend class MovieClipAnimator;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(MovieClip);
@@ -0,0 +1,55 @@
+#include "MovieClipAnimator.h"
+#include "MovieClip.h"
+#include "FGUIManager.h"
+#include "utils/Profiler.h"
+
+NS_FGUI_BEGIN
+
+MovieClipAnimator::MovieClipAnimator()
+{
+}
+
+MovieClipAnimator::~MovieClipAnimator()
+{
+    for (auto &it : _clips)
+        it->_animatorIndex = -1;
+}
+
+void MovieClipAnimator::add(MovieClip * clip)
+{
+    if (clip->_animatorIndex != -1)
+        return;
+
+    clip->_animatorIndex = (int)_clips.size();
+    _clips.push_back(clip);
+}
+
+void MovieClipAnimator::remove(MovieClip * clip)
+{
+    int index = clip->_animatorIndex;
+    if (index == -1)
+        return;
+
+    //the order of advancing does not matter, so the last clip takes the free slot
+    MovieClip* last = _clips.back();
+    _clips[index] = last;
+    last->_animatorIndex = index;
+    _clips.pop_back();
+    clip->_animatorIndex = -1;
+}
+
+void MovieClipAnimator::update(float dt)
+{
+    FGUI_PROFILE_ZONE("MovieClipAnimator::update");
+
+    int frameId = FGUIManager::GlobalManager().getFrameCount();
+    int cnt = (int)_clips.size();
+    for (int i = 0; i < cnt; i++)
+    {
+        MovieClip* clip = _clips[i];
+        if (clip->_updateFrameId == frameId)
+            clip->advance(dt);
+    }
+}
+
+NS_FGUI_END
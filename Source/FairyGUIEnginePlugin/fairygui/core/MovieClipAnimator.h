@@ -0,0 +1,32 @@
+#ifndef __MOVIECLIPANIMATOR_H__
+#define __MOVIECLIPANIMATOR_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+class MovieClip;
+
+//Advances all MovieClips in one pass after the display list update, instead of each
+//clip stepping itself inside the recursive walk. Only clips the walk reached in this
+//frame move on, so hidden or removed clips pause as before. A frame change is drawn
+//when the clip is next rendered, clips that are culled only advance their time.
+class FGUI_IMPEXP MovieClipAnimator
+{
+public:
+    MovieClipAnimator();
+    ~MovieClipAnimator();
+
+    void add(MovieClip* clip);
+    void remove(MovieClip* clip);
+    void update(float dt);
+
+    int getClipCount() const { return (int)_clips.size(); }
+
+private:
+    std::vector<MovieClip*> _clips;
+};
+
+NS_FGUI_END
+
+#endif
@@ -3,6 +3,10 @@
 #include "FGUIManager.h"
 #include "TextField.h"
 #include "NativeFont.h"
+#include "TextureResidencyManager.h"
+#include "TextureCache.h"
+#include "DynamicAtlas.h"
+#include "utils/Profiler.h"
 
 NS_FGUI_BEGIN
 
@@ -12,7 +16,9 @@ NGraphics::NGraphics() :
     _texture(nullptr),
     _alpha(1),
     _dirty(true),
+    _meshBoundsDirty(true),
     _ignoreClipping(false),
+    _textureWrap(false),
     _matrixVersion(0),
     _enabled(true),
     _font(nullptr),
@@ -41,7 +47,30 @@ void NGraphics::render(RenderContext* context, const hkvMat4& localToWorldMatrix
 
     alpha *= context->alpha;
 
-    if (_texture != nullptr && !_vertexBuffer.IsEmpty())
+    if (_texture != nullptr && _sharedMesh != nullptr)
+    {
+        //a shared mesh is never modified, _vertexBuffer keeps the transformed copy of it
+        if (_dirty || _alpha != alpha || _matrixVersion != matrixVersion)
+        {
+            _dirty = false;
+            _alpha = alpha;
+            _matrixVersion = matrixVersion;
+
+            const hkvArray<Overlay2DVertex_t>& vertices = _sharedMesh->getVertices();
+            int cnt = vertices.GetSize();
+            _vertexBuffer.SetSize(cnt);
+            for (int i = 0; i < cnt; i++)
+            {
+                Overlay2DVertex_t& m = _vertexBuffer[i];
+                m = vertices[i];
+                m.color.a = (UBYTE)(m.color.a * _alpha);
+                m.screenPos = localToWorldMatrix.transformPosition(m.screenPos.getAsVec3(0)).getAsVec2();
+            }
+        }
+
+        draw(context, _vertexBuffer);
+    }
+    else if (_texture != nullptr && !_vertexBuffer.IsEmpty())
     {
         if (_dirty)
         {
@@ -89,13 +118,7 @@ void NGraphics::render(RenderContext* context, const hkvMat4& localToWorldMatrix
             }
         }
 
-        if (_ignoreClipping)
-            context->enableClipping(false);
-
-        context->getRenderer()->Draw2DBuffer(_vertexBuffer.GetSize(), _vertexBuffer.GetDataPointer(), _texture->getNativeTexture(), context->getRenderState());
-
-        if (_ignoreClipping)
-            context->enableClipping(true);
+        draw(context, _vertexBuffer);
     }
 
     if (_textElements)
@@ -127,22 +150,138 @@ void NGraphics::render(RenderContext* context, const hkvMat4& localToWorldMatrix
 
             if (_font->simulateOutline && re->format->hasEffect(TextFormat::OUTLINE))
             {
-                _font->getVisFont()->PrintText(context->getRenderer(), screenPos + hkvVec2(-re->format->outlineSize, 0), vDir, vUp, re->text.c_str(), re->format->outlineColor, context->getRenderState());
-                _font->getVisFont()->PrintText(context->getRenderer(), screenPos + hkvVec2(re->format->outlineSize, 0), vDir, vUp, re->text.c_str(), re->format->outlineColor, context->getRenderState());
-                _font->getVisFont()->PrintText(context->getRenderer(), screenPos + hkvVec2(0, re->format->outlineSize), vDir, vUp, re->text.c_str(), re->format->outlineColor, context->getRenderState());
-                _font->getVisFont()->PrintText(context->getRenderer(), screenPos + hkvVec2(0, -re->format->outlineSize), vDir, vUp, re->text.c_str(), re->format->outlineColor, context->getRenderState());
+                _font->printText(context, screenPos + hkvVec2(-re->format->outlineSize, 0), vDir, vUp, re->text.c_str(), re->format->outlineColor);
+                _font->printText(context, screenPos + hkvVec2(re->format->outlineSize, 0), vDir, vUp, re->text.c_str(), re->format->outlineColor);
+                _font->printText(context, screenPos + hkvVec2(0, re->format->outlineSize), vDir, vUp, re->text.c_str(), re->format->outlineColor);
+                _font->printText(context, screenPos + hkvVec2(0, -re->format->outlineSize), vDir, vUp, re->text.c_str(), re->format->outlineColor);
             }
 
             if (re->format->hasEffect(TextFormat::SHADOW))
-                _font->getVisFont()->PrintText(context->getRenderer(), screenPos + re->format->shadowOffset, vDir, vUp, re->text.c_str(), re->format->shadowColor, context->getRenderState());
+                _font->printText(context, screenPos + re->format->shadowOffset, vDir, vUp, re->text.c_str(), re->format->shadowColor);
 
-            _font->getVisFont()->PrintText(context->getRenderer(), screenPos, vDir, vUp, re->text.c_str(), color, context->getRenderState());
+            _font->printText(context, screenPos, vDir, vUp, re->text.c_str(), color);
         }
     }
 }
 
+void NGraphics::draw(RenderContext* context, hkvArray<Overlay2DVertex_t>& vertices)
+{
+    FGUIManager::GlobalManager().getTextureResidencyManager()->touch(_texture);
+    FGUI_PROFILE_COUNT(DRAW_CALLS, 1);
+    FGUI_PROFILE_COUNT(VERTICES, vertices.GetSize());
+#if FGUI_ENABLE_PROFILER
+    //two different images in a row from one dynamic atlas page would have been two textures without it
+    if (context->lastTexture != nullptr && context->lastTexture != _texture && context->lastTexture->getRoot() == _texture->getRoot()
+        && FGUIManager::GlobalManager().getTextureCache()->getDynamicAtlas()->isPage(_texture->getRoot()))
+        FGUI_PROFILE_COUNT(ATLAS_DRAWS_SAVED, 1);
+#endif
+    context->lastTexture = _texture;
+
+    if (_ignoreClipping)
+        context->enableClipping(false);
+
+    if (_textureWrap)
+    {
+        VSimpleRenderState_t renderState = context->getRenderState();
+        renderState.SetFlag(RENDERSTATEFLAG_TEXTUREWRAP);
+        context->getRenderer()->Draw2DBuffer(vertices.GetSize(), vertices.GetDataPointer(), _texture->getNativeTexture(), renderState);
+    }
+    else
+        context->getRenderer()->Draw2DBuffer(vertices.GetSize(), vertices.GetDataPointer(), _texture->getNativeTexture(), context->getRenderState());
+
+    if (_ignoreClipping)
+        context->enableClipping(true);
+}
+
+bool NGraphics::useSharedMesh(const MeshKey& key)
+{
+    SharedMesh* mesh = MeshCache::get(key);
+    if (mesh == nullptr)
+        return false;
+
+    _vertexBuffer.Clear();
+    _alphaBackup.Clear();
+    _positionBackup.Clear();
+    _sharedMesh = mesh;
+    _textureWrap = mesh->isTextureWrap();
+    _dirty = true;
+    _meshBoundsDirty = true;
+    return true;
+}
+
+void NGraphics::shareMesh(const MeshKey& key)
+{
+    if (_sharedMesh != nullptr || _vertexBuffer.IsEmpty())
+        return;
+
+    _sharedMesh = MeshCache::add(key, _vertexBuffer, _textureWrap);
+    _vertexBuffer.Clear();
+    _alphaBackup.Clear();
+    _positionBackup.Clear();
+    _dirty = true;
+    _meshBoundsDirty = true;
+}
+
+void NGraphics::detachSharedMesh()
+{
+    if (_sharedMesh == nullptr)
+        return;
+
+    _vertexBuffer = _sharedMesh->getVertices();
+    _sharedMesh = nullptr;
+    _dirty = true;
+    _meshBoundsDirty = true;
+}
+
+int NGraphics::getVertexCount() const
+{
+    if (_sharedMesh != nullptr)
+        return _sharedMesh->getVertices().GetSize();
+    else
+        return _vertexBuffer.GetSize();
+}
+
+const VRectanglef& NGraphics::getMeshBounds()
+{
+    if (_meshBoundsDirty)
+    {
+        _meshBoundsDirty = false;
+
+        //render transforms _vertexBuffer in place, the local positions are in _positionBackup then
+        bool backup = _sharedMesh == nullptr && !_dirty;
+        const hkvArray<Overlay2DVertex_t>& vertices = _sharedMesh != nullptr ? _sharedMesh->getVertices() : _vertexBuffer;
+        int cnt = backup ? _positionBackup.GetSize() : vertices.GetSize();
+        if (cnt == 0)
+            _meshBounds = VRectanglef(0, 0, 0, 0);
+        else
+        {
+            hkvVec2 vMin = backup ? _positionBackup[0] : vertices[0].screenPos;
+            hkvVec2 vMax = vMin;
+            for (int i = 1; i < cnt; i++)
+            {
+                const hkvVec2& pos = backup ? _positionBackup[i] : vertices[i].screenPos;
+                vMin.x = MIN(vMin.x, pos.x);
+                vMin.y = MIN(vMin.y, pos.y);
+                vMax.x = MAX(vMax.x, pos.x);
+                vMax.y = MAX(vMax.y, pos.y);
+            }
+            _meshBounds = VRectanglef(vMin.x, vMin.y, vMax.x, vMax.y);
+        }
+    }
+    return _meshBounds;
+}
+
+size_t NGraphics::getMemoryUsage() const
+{
+    //a shared mesh belongs to MeshCache and is not counted here, its transformed copy (in _vertexBuffer) is
+    return _vertexBuffer.GetCapacity() * sizeof(Overlay2DVertex_t)
+        + _alphaBackup.GetCapacity() * sizeof(UBYTE)
+        + _positionBackup.GetCapacity() * sizeof(hkvVec2);
+}
+
 void NGraphics::clearMesh()
 {
+    _sharedMesh = nullptr;
     _vertexBuffer.Clear();
     _alphaBackup.Clear();
     _positionBackup.Clear();
@@ -150,34 +289,71 @@ void NGraphics::clearMesh()
     _textElements = nullptr;
     _matrixVersion = 0;
     _alpha = 1;
+    _meshBoundsDirty = true;
 }
 
 void NGraphics::addVertex(const hkvVec2& pos, const hkvVec2& uv, const VColorRef& color)
 {
+    detachSharedMesh();
     Overlay2DVertex_t v0;
     v0.Set(pos.x, pos.y, uv.x, uv.y, color);
     _vertexBuffer.PushBack(v0);
     _dirty = true;
+    _meshBoundsDirty = true;
 }
 
 void NGraphics::addQuad(const VRectanglef& drawRect, const VRectanglef& uvRect, const VColorRef& color)
 {
-    Overlay2DVertex_t v0;
-    v0.Set(drawRect.m_vMin.x, drawRect.m_vMin.y, uvRect.m_vMin.x, uvRect.m_vMin.y, color);
-    Overlay2DVertex_t v1;
-    v1.Set(drawRect.m_vMax.x, drawRect.m_vMin.y, uvRect.m_vMax.x, uvRect.m_vMin.y, color);
-    Overlay2DVertex_t v2;
-    v2.Set(drawRect.m_vMax.x, drawRect.m_vMax.y, uvRect.m_vMax.x, uvRect.m_vMax.y, color);
-    Overlay2DVertex_t v3;
-    v3.Set(drawRect.m_vMin.x, drawRect.m_vMax.y, uvRect.m_vMin.x, uvRect.m_vMax.y, color);
+    writeQuad(addQuads(1), drawRect, uvRect, color);
+}
 
-    _vertexBuffer.PushBack(v0);
-    _vertexBuffer.PushBack(v3);
-    _vertexBuffer.PushBack(v1);
-    _vertexBuffer.PushBack(v3);
-    _vertexBuffer.PushBack(v2);
-    _vertexBuffer.PushBack(v1);
+Overlay2DVertex_t* NGraphics::addQuads(int count)
+{
+    detachSharedMesh();
+
+    int start = _vertexBuffer.GetSize();
+    _vertexBuffer.SetSize(start + count * 6);
     _dirty = true;
+    _meshBoundsDirty = true;
+
+    return _vertexBuffer.GetDataPointer() + start;
+}
+
+void NGraphics::writeQuad(Overlay2DVertex_t* dest, const VRectanglef& drawRect, const VRectanglef& uvRect, const VColorRef& color)
+{
+    //two triangles: min, bottom left, top right and bottom left, max, top right
+    dest[0].Set(drawRect.m_vMin.x, drawRect.m_vMin.y, uvRect.m_vMin.x, uvRect.m_vMin.y, color);
+    dest[1].Set(drawRect.m_vMin.x, drawRect.m_vMax.y, uvRect.m_vMin.x, uvRect.m_vMax.y, color);
+    dest[2].Set(drawRect.m_vMax.x, drawRect.m_vMin.y, uvRect.m_vMax.x, uvRect.m_vMin.y, color);
+    dest[3] = dest[1];
+    dest[4].Set(drawRect.m_vMax.x, drawRect.m_vMax.y, uvRect.m_vMax.x, uvRect.m_vMax.y, color);
+    dest[5] = dest[2];
+}
+
+bool NGraphics::updateQuad(const VRectanglef& drawRect, const VRectanglef& uvRect)
+{
+    //moves the single quad made by addQuad in place, keeping its color
+    if (_sharedMesh != nullptr || _vertexBuffer.GetSize() != 6)
+        return false;
+
+    const hkvVec2 pos[6] = {
+        drawRect.m_vMin, hkvVec2(drawRect.m_vMin.x, drawRect.m_vMax.y), hkvVec2(drawRect.m_vMax.x, drawRect.m_vMin.y),
+        hkvVec2(drawRect.m_vMin.x, drawRect.m_vMax.y), drawRect.m_vMax, hkvVec2(drawRect.m_vMax.x, drawRect.m_vMin.y) };
+    const hkvVec2 uv[6] = {
+        uvRect.m_vMin, hkvVec2(uvRect.m_vMin.x, uvRect.m_vMax.y), hkvVec2(uvRect.m_vMax.x, uvRect.m_vMin.y),
+        hkvVec2(uvRect.m_vMin.x, uvRect.m_vMax.y), uvRect.m_vMax, hkvVec2(uvRect.m_vMax.x, uvRect.m_vMin.y) };
+
+    for (int i = 0; i < 6; i++)
+    {
+        Overlay2DVertex_t& m = _vertexBuffer[i];
+        if (!_dirty)
+            m.color.a = _alphaBackup[i];
+        m.screenPos = pos[i];
+        m.texCoord = uv[i];
+    }
+    _dirty = true;
+    _meshBoundsDirty = true;
+    return true;
 }
 
 void NGraphics::drawRect(const VRectanglef& vertRect, float lineSize, const VColorRef& lineColor, const VColorRef& fillColor)
@@ -218,6 +394,8 @@ void NGraphics::drawEllipse(const VRectanglef& vertRect, const VColorRef& color)
     float angleDelta = 2 * hkvMath::pi() / numSides;
     float angle = 0;
 
+    detachSharedMesh();
+
     Overlay2DVertex_t v0;
     Overlay2DVertex_t v1;
     Overlay2DVertex_t v2;
@@ -241,6 +419,7 @@ void NGraphics::drawEllipse(const VRectanglef& vertRect, const VColorRef& color)
     }
 
     _dirty = true;
+    _meshBoundsDirty = true;
 }
 
 void NGraphics::drawText(NativeFont* font, std::vector<TextRenderElement*>* renderElements)
@@ -254,6 +433,8 @@ void NGraphics::drawText(NativeFont* font, std::vector<TextRenderElement*>* rend
 
 void NGraphics::rotateUV(const VRectanglef& baseUVRect)
 {
+    detachSharedMesh();
+
     float xMin = MIN(baseUVRect.m_vMin.x, baseUVRect.m_vMax.x);
     float yMin = baseUVRect.m_vMin.y;
     float yMax = baseUVRect.m_vMax.y;
@@ -276,13 +457,18 @@ void NGraphics::rotateUV(const VRectanglef& baseUVRect)
 
 void NGraphics::tint(const VColorRef & color)
 {
+    detachSharedMesh();
+
     int cnt = _vertexBuffer.GetSize();
     for (int i = 0; i < cnt; i++)
     {
         Overlay2DVertex_t& m = _vertexBuffer[i];
         m.color = color;
-        _alphaBackup[i] = m.color.a;
-        m.color.a = (UBYTE)(m.color.a * _alpha);
+        if (!_dirty)
+        {
+            _alphaBackup[i] = m.color.a;
+            m.color.a = (UBYTE)(m.color.a * _alpha);
+        }
     }
 }
 
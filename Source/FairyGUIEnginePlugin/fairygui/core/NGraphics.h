@@ -3,6 +3,8 @@
 
 #include "FGUIMacros.h"
 #include "NTexture.h"
+#include "MeshCache.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
@@ -14,41 +16,63 @@ class NativeFont;
 class FGUI_IMPEXP NGraphics
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     NGraphics();
     ~NGraphics();
 
     NTexture* getTexture() const { return _texture; }
     void setTexture(NTexture* value);
     void setWhiteTexture();
+    bool isIgnoreClipping() const { return _ignoreClipping; }
     void setIgnoreClipping(bool value) { _ignoreClipping = value; }
+    void setTextureWrap(bool value) { _textureWrap = value; }
 
     bool isEnabled() const { return _enabled; }
     void setEnabled(bool value) { _enabled = value; }
 
     void addVertex(const hkvVec2& pos, const hkvVec2& uv, const VColorRef& color);
     void addQuad(const VRectanglef& drawRect, const VRectanglef& uvRect, const VColorRef& color);
+    //grows the mesh by count quads and returns their count * 6 vertices, to be filled with writeQuad
+    Overlay2DVertex_t* addQuads(int count);
+    bool updateQuad(const VRectanglef& drawRect, const VRectanglef& uvRect);
     void drawRect(const VRectanglef& vertRect, float lineSize, const VColorRef& lineColor, const VColorRef& fillColor);
     void drawEllipse(const VRectanglef& vertRect, const VColorRef& color);
     void drawText(NativeFont* font, std::vector<TextRenderElement*>* renderElements);
     void clearMesh();
+    bool useSharedMesh(const MeshKey& key);
+    void shareMesh(const MeshKey& key);
     void rotateUV(const VRectanglef& baseUVRect);
     void tint(const VColorRef& color);
     void blink() { _enabled = !_enabled; }
+    int getVertexCount() const;
+    size_t getMemoryUsage() const;
+    //the extents of the mesh in local space, empty without one
+    const VRectanglef& getMeshBounds();
 
     void render(RenderContext* context, const hkvMat4& localToWorldMatrix, hkUint32 matrixVersion, float alpha);
 
+    static void writeQuad(Overlay2DVertex_t* dest, const VRectanglef& drawRect, const VRectanglef& uvRect, const VColorRef& color);
+
     static const VRectanglef FULL_UV;
 
 private:
+    void draw(RenderContext* context, hkvArray<Overlay2DVertex_t>& vertices);
+    void detachSharedMesh();
+
     RefPtr<NTexture> _texture;
+    RefPtr<SharedMesh> _sharedMesh;
     hkvArray<Overlay2DVertex_t> _vertexBuffer;
     NativeFont* _font;
     std::vector<TextRenderElement*>* _textElements;
     hkvArray<UBYTE> _alphaBackup;
     hkvArray<hkvVec2> _positionBackup;
+    VRectanglef _meshBounds;
     float _alpha;
     bool _dirty;
+    bool _meshBoundsDirty;
     bool _ignoreClipping;
+    bool _textureWrap;
     bool _enabled;
     hkUint32 _matrixVersion;
 };
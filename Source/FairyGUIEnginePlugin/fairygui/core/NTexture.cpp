@@ -4,6 +4,7 @@ NS_FGUI_BEGIN
 
 NTexture::NTexture() :
     lastActive(0),
+    _root(nullptr),
     _nativeTexture(nullptr),
     _region(nullptr),
     _rotated(false)
@@ -13,6 +14,7 @@ NTexture::NTexture() :
 
 NTexture::NTexture(VTextureObject * texture, float xScale, float yScale) :
     lastActive(0),
+    _root(nullptr),
     _region(nullptr),
     _rotated(false)
 {
@@ -24,6 +26,8 @@ NTexture::NTexture(VTextureObject * texture, float xScale, float yScale) :
 NTexture::NTexture(NTexture * root, const VRectanglef & region, bool rotated) :
     lastActive(0)
 {
+    _root = root->getRoot();
+    _root->retain();
     _nativeTexture = root->getNativeTexture();
     _region = new VRectanglef(region);
     if (_nativeTexture != nullptr)
@@ -47,6 +51,13 @@ NTexture::NTexture(NTexture * root, const VRectanglef & region, bool rotated) :
     updateSize();
 }
 
+bool NTexture::isRepeatable() const
+{
+    //only a whole native texture can use wrap addressing, a region of an atlas would bleed into its neighbours
+    return _region == nullptr && _nativeTexture != nullptr
+        && _uvRect.m_vMin.x == 0 && _uvRect.m_vMin.y == 0 && _uvRect.m_vMax.x == 1 && _uvRect.m_vMax.y == 1;
+}
+
 void NTexture::updateSize()
 {
     if (_region != nullptr)
@@ -60,6 +71,7 @@ void NTexture::updateSize()
 NTexture::~NTexture()
 {
     CC_SAFE_DELETE(_region);
+    CC_SAFE_RELEASE(_root);
 }
 
 NS_FGUI_END
\ No newline at end of file
@@ -16,6 +16,8 @@ public:
     VTextureObject* getNativeTexture() const { return _nativeTexture; }
     const VRectanglef& getUVRect() const { return _uvRect; }
     const bool isRotated() const { return _rotated; }
+    NTexture* getRoot() { return _root != nullptr ? _root : this; }
+    bool isRepeatable() const;
 
     int getWidth() const { return _size.x; }
     int getHeight() const { return _size.y; }
@@ -25,6 +27,7 @@ public:
 private:
     void updateSize();
 
+    NTexture* _root;
     VTextureObjectPtr _nativeTexture;
     VRectanglef _uvRect;
     VRectanglef* _region;
@@ -24,12 +24,14 @@ NativeFont::~NativeFont()
 int NativeFont::getCharacterIndexAtPos(const char * szText, const TextFormat & format, float fHorizPos, int iCharCount)
 {
     float scale = scaleEnabled ? _fontSize / format.size : 1;
+    std::lock_guard<std::mutex> lock(_measureMutex);
     return _visFontPtr->GetCharacterIndexAtPos(szText, fHorizPos * scale, iCharCount, false);
 }
 
 bool NativeFont::getTextDimension(const char * szText, const TextFormat & format, VRectanglef & dest, int iCharCount)
 {
     float scale = scaleEnabled ? format.size / _fontSize : 1;
+    std::lock_guard<std::mutex> lock(_measureMutex);
     if (_visFontPtr->GetTextDimension(szText, dest, iCharCount))
     {
         dest.m_vMax *= scale;
@@ -41,9 +43,16 @@ bool NativeFont::getTextDimension(const char * szText, const TextFormat & format
 
 int NativeFont::getLineHeight(const TextFormat & format)
 {
+    std::lock_guard<std::mutex> lock(_measureMutex);
     return scaleEnabled ? (format.size * _visFontPtr->m_fLineHeight / _fontSize) : _visFontPtr->m_fLineHeight;
 }
 
+void NativeFont::printText(RenderContext* context, const hkvVec2& pos, const hkvVec2& dir, const hkvVec2& up, const char* text, const VColorRef& color)
+{
+    std::lock_guard<std::mutex> lock(_measureMutex);
+    _visFontPtr->PrintText(context->getRenderer(), pos, dir, up, text, color, context->getRenderState());
+}
+
 void NativeFont::prepareGraphics(NGraphics & graphics, TextRenderElement & re)
 {
     if (!re.format->underline || re.size.x == 0)
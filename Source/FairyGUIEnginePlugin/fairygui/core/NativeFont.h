@@ -4,6 +4,8 @@
 #include "FGUIMacros.h"
 #include "BaseFont.h"
 
+#include <mutex>
+
 NS_FGUI_BEGIN
 
 class RenderContext;
@@ -19,6 +21,7 @@ public:
     virtual bool getTextDimension(const char *szText, const TextFormat & format, VRectanglef &dest, int iCharCount = -1) override;
     virtual int getLineHeight(const TextFormat & format)  override;
     virtual void prepareGraphics(NGraphics& graphics, TextRenderElement& re) override;
+    void printText(RenderContext* context, const hkvVec2& pos, const hkvVec2& dir, const hkvVec2& up, const char* text, const VColorRef& color);
 
     VisFont_cl* getVisFont() const { return _visFontPtr; }
     float getFontSize() const { return _fontSize; }
@@ -28,6 +31,9 @@ protected:
     VisFontPtr _visFontPtr;
     float _scale;
     float _fontSize;
+    //VisFont_cl is not documented as thread safe, and TextMeasurer measures on its own thread
+    //while the main thread prints
+    std::mutex _measureMutex;
 };
 
 NS_FGUI_END
@@ -4,7 +4,8 @@
 
 NS_FGUI_BEGIN
 
-RenderContext::RenderContext()
+RenderContext::RenderContext() :
+    lastTexture(nullptr)
 {
     _renderState = VSimpleRenderState_t(VIS_TRANSP_ALPHA, RENDERSTATEFLAG_ALWAYSVISIBLE | RENDERSTATEFLAG_FRONTFACE | RENDERSTATEFLAG_USESCISSORTEST | RENDERSTATEFLAG_USEADDITIVEALPHA | RENDERSTATEFLAG_FILTERING);
 }
@@ -16,6 +17,7 @@ void RenderContext::begin()
 
     clipped = false;
     _clipStack.clear();
+    lastTexture = nullptr;
 
     _renderer = Vision::RenderLoopHelper.BeginOverlayRendering();
 }
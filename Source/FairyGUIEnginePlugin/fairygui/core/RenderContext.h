@@ -5,6 +5,8 @@
 
 NS_FGUI_BEGIN
 
+class NTexture;
+
 class FGUI_IMPEXP RenderContext
 {
 public:
@@ -29,6 +31,12 @@ public:
 	float alpha;
 	bool grayed;
 
+	//scratch buffer for meshes that are transformed at draw time
+	hkvArray<Overlay2DVertex_t> vertexBuffer;
+
+	//texture of the previous draw, see NGraphics::draw
+	NTexture* lastTexture;
+
 	IVRender2DInterface* getRenderer() const { return _renderer; }
 	const VSimpleRenderState_t& getRenderState() const { return _renderState; }
 
@@ -32,6 +32,7 @@ void SelectionShape::setRects(const std::vector<VRectanglef>& rects)
     else
         _contentRect.Set(0, 0, 0, 0);
     _requireUpdateMesh = true;
+    _hitVersion++;
 }
 
 void SelectionShape::setColor(const VColorRef & color)
@@ -51,6 +52,7 @@ void SelectionShape::clear()
         _contentRect.Set(0, 0, 0, 0);
         onSizeChanged(true, true);
         _requireUpdateMesh = true;
+        _hitVersion++;
     }
 }
 
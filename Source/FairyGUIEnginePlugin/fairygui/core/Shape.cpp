@@ -37,6 +37,7 @@ void Shape::drawRect(int lineSize, const VColorRef & lineColor, const VColorRef
     _fillColor = fillColor;
 
     _touchDisabled = false;
+    _hitVersion++;
     _requireUpdateMesh = true;
 }
 
@@ -46,6 +47,7 @@ void Shape::drawEllipse(const VColorRef& color)
     _fillColor = color;
 
     _touchDisabled = false;
+    _hitVersion++;
     _requireUpdateMesh = true;
 }
 
@@ -53,6 +55,7 @@ void Shape::clear()
 {
     _type = 0;
     _touchDisabled = true;
+    _hitVersion++;
     _graphics->clearMesh();
 }
 
@@ -7,6 +7,12 @@
 #include "GRoot.h"
 #include "UIPackage.h"
 #include "FGUIManager.h"
+#include "Image.h"
+#include "TextField.h"
+#include "DeviceInputSource.h"
+#include "InputRecorder.h"
+#include "utils/WorkerPool.h"
+#include "utils/Profiler.h"
 
 NS_FGUI_BEGIN
 
@@ -27,7 +33,9 @@ public:
     bool began;
     bool clickCancelled;
     bool moved;
-    clock_t lastClickTime;
+    float lastClickTime;
+    hkvVec2 hitPos;
+    unsigned int hitVersion;
     WeakPtr target;
     WeakPtr lastRollOver;
     std::vector<WeakPtr> downTargets;
@@ -41,23 +49,19 @@ Stage::Stage() :
     _touchPosition(0, 0),
     _caret(nullptr),
     _selectionShape(nullptr),
-    _multiTouchInput(nullptr),
-    _mouseInput(nullptr),
-    _capsLockOn(false),
+    _deviceInput(nullptr),
+    _inputSource(nullptr),
+    _recorder(nullptr),
     _soundEnabled(true),
-    _soundVolumeScale(1.0f)
+    _soundVolumeScale(1.0f),
+    _collectingRebuilds(false)
 {
     for (int i = 0; i < 5; i++)
         _touches.push_back(new TouchInfo());
     _recentInput = &_touches[0]->evt;
 
-    _keyStatus = new float[256];
-    for (int i = 0; i < 256; i++)
-        _keyStatus[i] = -1;
-
-    _mouseInput = static_cast<VMousePC*>(&VInputManager::GetMouse());
-    if (_mouseInput == nullptr)
-        _multiTouchInput = static_cast<IVMultiTouchInput*>(&VInputManager::GetInputDevice(INPUT_DEVICE_TOUCHSCREEN));
+    _deviceInput = new DeviceInputSource();
+    _inputSource = _deviceInput;
 
     setSize((float)Vision::Video.GetXRes(), (float)Vision::Video.GetYRes());
 
@@ -76,7 +80,8 @@ Stage::~Stage()
 {
     for (auto &ti : _touches)
         delete ti;
-    delete _keyStatus;
+    delete _deviceInput;
+    delete _recorder;
 
     CC_SAFE_RELEASE(_caret);
     CC_SAFE_RELEASE(_selectionShape);
@@ -177,202 +182,310 @@ void Stage::setSoundVolumeScale(float value)
     _soundVolumeScale = value;
 }
 
-void Stage::update(float dt)
+void Stage::setInputSource(IInputSource * source)
 {
-    parseHit();
+    _inputSource = source != nullptr ? source : _deviceInput;
+}
 
-    if (_multiTouchInput != nullptr)
-        handleTouchInput();
-    else
-        handleMouseInput();
-#ifdef SUPPORTS_KEYBOARD
-    handleKeyboardInput();
-#endif
+bool Stage::startRecording(const std::string & filePath)
+{
+    if (_recorder == nullptr)
+        _recorder = new InputRecorder();
+    return _recorder->start(filePath);
+}
 
-    DisplayObject::update(dt);
+void Stage::stopRecording()
+{
+    if (_recorder != nullptr)
+        _recorder->stop();
 }
 
-void Stage::parseHit()
+bool Stage::isRecording() const
 {
-    if (_multiTouchInput != nullptr)
-    {
-        _touchTarget = nullptr;
-        for (int i = 0; i < _multiTouchInput->GetNumberOfTouchPoints(); ++i)
-        {
-            if (!_multiTouchInput->IsActiveTouch(i))
-                continue;
+    return _recorder != nullptr && _recorder->isRecording();
+}
 
-            auto uTouch = _multiTouchInput->GetTouch(i);
+void Stage::update(float dt)
+{
+    parseHit();
+    processInput();
 
-            TouchInfo* touch = nullptr;
-            TouchInfo* free = nullptr;
-            for (int j = 0; j < 5; j++)
-            {
-                if (_touches[j]->touchId == uTouch.iID)
-                {
-                    touch = _touches[j];
-                    break;
-                }
+    _collectingRebuilds = true;
+    DisplayObject::update(dt);
+    _collectingRebuilds = false;
 
-                if (_touches[j]->touchId == -1)
-                    free = _touches[j];
-            }
-            if (touch == nullptr)
-            {
-                touch = free;
-                if (touch == nullptr)
-                    continue;
+    flushRebuilds();
+}
 
-                touch->touchId = uTouch.iID;
-            }
+bool Stage::queueRebuild(Image * image)
+{
+    if (!_collectingRebuilds)
+        return false;
 
-            _touchTarget = hitTest(touch->pos, true);
-            touch->target = _touchTarget;
-        }
-    }
-    else
-    {
-        TouchInfo* touch = _touches[0];
-        _touchPosition = hkvVec2(_mouseInput->GetRawControlValue(CT_MOUSE_ABS_X), _mouseInput->GetRawControlValue(CT_MOUSE_ABS_Y));
-
-        touch->moved = _touchPosition != touch->pos;
-        touch->pos = _touchPosition;
-        touch->touchId = 0;
-        _touchTarget = hitTest(_touchPosition, true);
-        if (_touchTarget == nullptr)
-            _touchTarget = this;
-        touch->target = _touchTarget;
-    }
+    image->retain();
+    _rebuildQueue.push_back(image);
+    return true;
 }
 
-void Stage::handleMouseInput()
+bool Stage::queueLayout(TextField * textField)
 {
-    if (!FGUIManager::GlobalManager().isShowCursor())
-        return;
+    if (!_collectingRebuilds)
+        return false;
 
-    TouchInfo* touch = _touches[0];
-    DisplayObject* touchTarget = _touchTarget.ptr<DisplayObject>();
-
-    if (touch->moved)
-        setMove(touch);
+    textField->retain();
+    _layoutQueue.push_back(textField);
+    return true;
+}
 
-    if (touch->lastRollOver != touch->target)
-        handleRollOver(touch);
+void Stage::flushRebuilds()
+{
+    if (_rebuildQueue.empty() && _layoutQueue.empty())
+        return;
 
-    bool leftDown = _mouseInput->GetRawControlValue(CT_MOUSE_LEFT_BUTTON) != 0;
-    bool rightDown = _mouseInput->GetRawControlValue(CT_MOUSE_RIGHT_BUTTON) != 0;
-    bool middleDown = _mouseInput->GetRawControlValue(CT_MOUSE_MIDDLE_BUTTON) != 0;
+    FGUI_PROFILE_ZONE("Stage::flushRebuilds");
 
-    int wheelDelta = _mouseInput->GetRawControlValue(CT_MOUSE_WHEEL);
-    if (wheelDelta != 0)
+    //Releasing old meshes and looking up shared ones touch MeshCache and reference counts,
+    //so that part stays on this thread, as do whole images built from tile strips. What is left only writes to each image's own NGraphics.
+    int cnt = 0;
+    for (auto &it : _rebuildQueue)
     {
-        touch->mouseWheelDelta = -wheelDelta;
-        updateEvent(touch);
-        touchTarget->bubbleEvent(UIEventType::MouseWheel);
-        touch->mouseWheelDelta = 0;
+        if (!it->beginRebuild())
+            it->release();
+        else if (it->usesTileStrips())
+        {
+            it->buildMesh();
+            it->endRebuild();
+            it->growRenderBounds();
+            it->release();
+        }
+        else
+            _rebuildQueue[cnt++] = it;
     }
+    _rebuildQueue.resize(cnt);
 
-    if (leftDown || rightDown || middleDown)
+    //HTML parsing and the size changes of text fields stay on this thread, the line layout is
+    //only measuring. A field already laid out again since it was queued only needs its mesh.
+    int textCount = 0;
+    for (auto &it : _layoutQueue)
     {
-        if (!touch->began)
+        if (it->_textChanged)
         {
-            _touchCount = 1;
-            setBegin(touch);
-            touch->button = middleDown ? 2 : (rightDown ? 1 : 0);
-            setFocus(touchTarget);
-
-            updateEvent(touch);
-            dispatchEvent(UIEventType::StageTouchBegin);
-            touchTarget->bubbleEvent(UIEventType::TouchBegin);
+            if (it->_font == nullptr)
+                it->resolveFont();
+            it->beginBuildLines();
+            _layoutQueue[textCount++] = it;
+        }
+        else
+        {
+            it->rebuild();
+            it->growRenderBounds();
+            it->release();
         }
     }
-    else if (touch->began)
-    {
-        _touchCount = 0;
-        setEnd(touch);
+    _layoutQueue.resize(textCount);
 
-        DisplayObject* clickTarget = clickTest(touch);
-        if (clickTarget != nullptr)
-        {
-            updateEvent(touch);
+    auto job = [this, cnt](int i)
+    {
+        if (i < cnt)
+            _rebuildQueue[i]->buildMesh();
+        else
+            _layoutQueue[i - cnt]->layoutLines();
+    };
+    int total = cnt + textCount;
+    if (total >= UIConfig::parallelRebuildThreshold)
+        FGUIManager::GlobalManager().getWorkerPool()->parallelFor(total, job);
+    else
+    {
+        for (int i = 0; i < total; i++)
+            job(i);
+    }
 
-            if (touch->button == 1)
-                clickTarget->bubbleEvent(UIEventType::RightClick);
-            else if (touch->button == 2)
-                clickTarget->bubbleEvent(UIEventType::MiddleClick);
-            else
-                clickTarget->bubbleEvent(UIEventType::Click);
-        }
+    //in queue order, so meshes are shared exactly as the serial path would share them
+    for (auto &it : _rebuildQueue)
+    {
+        it->endRebuild();
+        it->growRenderBounds();
+        it->release();
+    }
+    _rebuildQueue.clear();
 
-        touch->button = -1;
+    for (auto &it : _layoutQueue)
+    {
+        it->buildLinesFinal();
+        it->rebuild();
+        it->growRenderBounds();
+        it->release();
     }
+    _layoutQueue.clear();
 }
 
-void Stage::handleTouchInput()
+void Stage::parseHit()
 {
-    for (int i = 0; i < _multiTouchInput->GetNumberOfTouchPoints(); ++i)
+    //pointer events hit test where they happen, this catches objects moving under a pointer that stays still
+    for (auto &touch : _touches)
     {
-        if (!_multiTouchInput->IsActiveTouch(i))
+        if (touch->touchId == -1)
             continue;
 
-        auto uTouch = _multiTouchInput->GetTouch(i);
+        updateTarget(touch);
+        _touchTarget = touch->target;
+
+        if (touch->touchId == 0 && touch->lastRollOver != touch->target)
+            handleRollOver(touch);
     }
 }
 
-void Stage::handleKeyboardInput()
+void Stage::processInput()
 {
-    int modifiers = 0;
+    _inputSource->poll(&_inputQueue);
+    if (_recorder != nullptr)
+        _recorder->writeFrame(_inputQueue.getRecords());
+    if (_inputQueue.isEmpty())
+        return;
 
-    if (VGLIsKeyPressed(VGLK_LSHIFT)) modifiers |= 4;
-    if (VGLIsKeyPressed(VGLK_RSHIFT)) modifiers |= 4;
-    if (VGLIsKeyPressed(VGLK_LCTRL)) modifiers |= 1;
-    if (VGLIsKeyPressed(VGLK_RCTRL)) modifiers |= 1;
-    if (VGLIsKeyPressed(VGLK_LALT)) modifiers |= 2;
-    if (VGLIsKeyPressed(VGLK_RALT)) modifiers |= 2;
+    //a handler may queue new events, they wait for the next frame
+    std::vector<InputRecord> records;
+    _inputQueue.drain(records);
 
-    for (int i = 1; i < 255; i++)
+    for (auto &it : records)
     {
-        if (VGLIsKeyPressed(i))
-            onKeyDown(i, modifiers);
-        else
-            _keyStatus[i] = -1;
+        switch (it.type)
+        {
+        case InputRecord::KEY:
+        case InputRecord::TEXT:
+            onKeyDown(it);
+            break;
+
+        default:
+            processPointer(it);
+            break;
+        }
     }
 }
 
-void Stage::onKeyDown(int keyId, int modifiers)
+void Stage::updateTarget(TouchInfo * touch)
 {
-    float currTime = Vision::GetTimer()->GetTime();
-    float status = _keyStatus[keyId];
-    if (status < 0)
+    //nothing that could change the result happened since the last test at this position
+    if (touch->hitVersion == DisplayObject::getHitVersion() && touch->hitPos == touch->pos
+        && touch->target.ptr() != nullptr)
     {
-        _keyStatus[keyId] = currTime + 0.5f;
+        FGUI_PROFILE_COUNT(HIT_TESTS_SKIPPED, 1);
+        return;
     }
-    else
+
+    FGUI_PROFILE_COUNT(HIT_TESTS, 1);
+    touch->hitVersion = DisplayObject::getHitVersion();
+    touch->hitPos = touch->pos;
+
+    DisplayObject* target = hitTest(touch->pos, true);
+    if (target == nullptr)
+        target = this;
+    touch->target = target;
+}
+
+void Stage::processPointer(const InputRecord & record)
+{
+    TouchInfo* touch = getTouch(record.touchId, true);
+    hkvVec2 pos(record.x, record.y);
+    touch->moved = pos != touch->pos;
+    touch->pos = pos;
+    _touchPosition = pos;
+
+    updateTarget(touch);
+    DisplayObject* target = touch->target.ptr<DisplayObject>();
+    _touchTarget = target;
+
+    if (touch->moved)
+        setMove(touch);
+
+    if (record.touchId == 0 && touch->lastRollOver != touch->target)
+        handleRollOver(touch);
+
+    switch (record.type)
     {
-        if (currTime - status < 0)
-            return;
+    case InputRecord::POINTER_DOWN:
+        if (!touch->began)
+        {
+            _touchCount++;
+            setBegin(touch);
+            touch->button = record.button;
+            setFocus(target);
+
+            updateEvent(touch);
+            dispatchEvent(UIEventType::StageTouchBegin);
+            target->bubbleEvent(UIEventType::TouchBegin);
+        }
+        break;
+
+    case InputRecord::POINTER_UP:
+        if (touch->began)
+        {
+            _touchCount--;
+            setEnd(touch, record.time);
+
+            DisplayObject* clickTarget = clickTest(touch);
+            if (clickTarget != nullptr)
+            {
+                updateEvent(touch);
+
+                if (touch->button == 1)
+                    clickTarget->bubbleEvent(UIEventType::RightClick);
+                else if (touch->button == 2)
+                    clickTarget->bubbleEvent(UIEventType::MiddleClick);
+                else
+                    clickTarget->bubbleEvent(UIEventType::Click);
+            }
 
-        _keyStatus[keyId] = currTime + 0.05f;
+            touch->button = -1;
+        }
+        //a finger that is lifted is gone, the mouse stays
+        if (record.touchId != 0)
+            touch->reset();
+        break;
+
+    case InputRecord::WHEEL:
+        touch->mouseWheelDelta = record.value;
+        updateEvent(touch);
+        target->bubbleEvent(UIEventType::MouseWheel);
+        touch->mouseWheelDelta = 0;
+        break;
+
+    default:
+        break;
     }
+}
 
-    if (keyId == VGLK_CAPS)
+static void appendUTF8(std::string& out, int c)
+{
+    if (c < 0x80)
+        out += (char)c;
+    else if (c < 0x800)
     {
-        _capsLockOn = !_capsLockOn;
-        return;
+        out += (char)(0xC0 | (c >> 6));
+        out += (char)(0x80 | (c & 0x3F));
     }
-
-    _recentInput->_keyCode = keyId;
-    if (keyId >= 32 && keyId <= 126)
+    else if (c < 0x10000)
     {
-        const VGLKey_t *pKeyTable = VGLGetKeyCharMap();
-        bool bCapital = (modifiers & 4) > 0;
-        if (_capsLockOn)
-            bCapital = !bCapital;
-        _recentInput->_keyName = static_cast<wchar_t>(bCapital ? pKeyTable[keyId].m_chUpper : pKeyTable[keyId].m_chLower);
+        out += (char)(0xE0 | (c >> 12));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
     }
     else
-        _recentInput->_keyName.clear();
-    _recentInput->_keyModifiers = modifiers;
+    {
+        out += (char)(0xF0 | (c >> 18));
+        out += (char)(0x80 | ((c >> 12) & 0x3F));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
+    }
+}
+
+void Stage::onKeyDown(const InputRecord& record)
+{
+    _recentInput->_keyCode = record.type == InputRecord::KEY ? record.value : 0;
+    _recentInput->_keyName.clear();
+    if (record.character != 0)
+        appendUTF8(_recentInput->_keyName, record.character);
+    _recentInput->_keyModifiers = record.modifiers;
     DisplayObject* target = _focused.ptr<DisplayObject>();
     _recentInput->_target = target;
 
@@ -479,7 +592,7 @@ void Stage::setBegin(TouchInfo* touch)
     }
 }
 
-void Stage::setEnd(TouchInfo* touch)
+void Stage::setEnd(TouchInfo* touch, float time)
 {
     touch->began = false;
 
@@ -517,8 +630,8 @@ void Stage::setEnd(TouchInfo* touch)
     if (target)
         target->bubbleEvent(UIEventType::TouchEnd);
 
-    auto now = clock();
-    float elapsed = (float)((now - touch->lastClickTime) / (double)CLOCKS_PER_SEC);
+    //timed by the event, so a replayed session counts the same double clicks
+    float elapsed = time - touch->lastClickTime;
 
     if (elapsed < 0.45f)
     {
@@ -529,7 +642,7 @@ void Stage::setEnd(TouchInfo* touch)
     }
     else
         touch->clickCount = 1;
-    touch->lastClickTime = now;
+    touch->lastClickTime = time;
 }
 
 void Stage::setMove(TouchInfo * touch)
@@ -586,7 +699,8 @@ TouchInfo::TouchInfo() :
     lastClickTime(0),
     clickCancelled(false),
     pos(0, 0),
-    moved(false)
+    moved(false),
+    hitVersion(0)
 {
 }
 
@@ -608,6 +722,7 @@ void TouchInfo::reset()
     began = false;
     downTargets.clear();
     lastRollOver = nullptr;
+    hitVersion = 0;
     clickCancelled = false;
     touchMonitors.clear();
 }
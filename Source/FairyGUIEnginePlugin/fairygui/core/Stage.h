@@ -3,13 +3,18 @@
 
 #include "FGUIMacros.h"
 #include "DisplayObject.h"
+#include "InputQueue.h"
 
 NS_FGUI_BEGIN
 
 class RenderContext;
 class TouchInfo;
 class Shape;
+class TextField;
 class SelectionShape;
+class Image;
+class DeviceInputSource;
+class InputRecorder;
 
 class FGUI_IMPEXP Stage : public DisplayObject
 {
@@ -34,8 +39,22 @@ public:
     float getSoundVolumeScale() const { return _soundVolumeScale; }
     void setSoundVolumeScale(float value);
 
+    //nullptr goes back to the Vision devices. The source is not owned by the stage.
+    void setInputSource(IInputSource* source);
+    IInputSource* getInputSource() const { return _inputSource; }
+    //platform code may queue timestamped events here, they are processed in the next update
+    InputQueue* getInputQueue() { return &_inputQueue; }
+
+    bool startRecording(const std::string& filePath);
+    void stopRecording();
+    bool isRecording() const;
+
     virtual void update(float dt) override;
 
+    //internal use
+    bool queueRebuild(Image* image);
+    bool queueLayout(TextField* textField);
+
 protected:
     Stage();
     virtual ~Stage();
@@ -45,33 +64,38 @@ private:
     void updateEvent(TouchInfo* ti);
     void handleRollOver(TouchInfo* touch);
     void setBegin(TouchInfo* touch);
-    void setEnd(TouchInfo* touch);
+    void setEnd(TouchInfo* touch, float time);
     void setMove(TouchInfo* touch);
     DisplayObject* clickTest(TouchInfo* touch);
-    void onKeyDown(int keyId, int modifiers);
+    void updateTarget(TouchInfo* touch);
+    void onKeyDown(const InputRecord& record);
 
     void parseHit();
-    void handleMouseInput();
-    void handleTouchInput();
-    void handleKeyboardInput();
+    void processInput();
+    void processPointer(const InputRecord& record);
+    void flushRebuilds();
 
-    IVMultiTouchInput* _multiTouchInput;
-    VMousePC* _mouseInput;
+    DeviceInputSource* _deviceInput;
+    IInputSource* _inputSource;
+    InputQueue _inputQueue;
+    InputRecorder* _recorder;
 
     std::vector<TouchInfo*> _touches;
     hkvVec2 _touchPosition;
     int _touchCount;
     WeakPtr _touchTarget;
     WeakPtr _focused;
-    float* _keyStatus;
     InputEvent* _recentInput;
-    bool _capsLockOn;
     bool _soundEnabled;
     float _soundVolumeScale;
 
     Shape* _caret;
     SelectionShape* _selectionShape;
 
+    std::vector<Image*> _rebuildQueue;
+    std::vector<TextField*> _layoutQueue;
+    bool _collectingRebuilds;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Stage);
 };
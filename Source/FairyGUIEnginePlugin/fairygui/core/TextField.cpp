@@ -8,6 +8,8 @@
 #include "NativeFont.h"
 #include "BitmapFont.h"
 #include "utils/ToolSet.h"
+#include "utils/Profiler.h"
+#include "utils/MemoryStats.h"
 
 #include <sstream>
 #include <vector>
@@ -395,12 +397,44 @@ void TextField::resolveFont()
 
 void TextField::update(float dt)
 {
-    if (_richTextField == nullptr)
+    //inside Stage::update the layout is deferred and done with the other text fields of the frame
+    if (_richTextField == nullptr && (!_textChanged || !StageInst->queueLayout(this)))
         rebuild();
 
     DisplayObject::update(dt);
 }
 
+VRectanglef TextField::getDrawRect()
+{
+    //lines longer or taller than the field are aligned past its edges, outline and shadow go further
+    VRectanglef rect = DisplayObject::getDrawRect();
+    if (_textBounds.x == 0 || _textBounds.y == 0)
+        return rect;
+
+    float rectWidth = _contentRect.GetSizeX() - GUTTER_X * 2;
+    float pad = _textFormat->outlineSize + MAX(std::abs(_textFormat->shadowOffset.x), std::abs(_textFormat->shadowOffset.y));
+    VRectanglef textRect(GUTTER_X + MIN(rectWidth - _textBounds.x, 0) - pad, MIN(_yOffset, 0) - pad,
+        GUTTER_X + MAX(rectWidth, _textBounds.x) + pad + _textFormat->size * 0.25f, _yOffset + _textBounds.y + pad);
+    return ToolSet::unionRect(rect, textRect);
+}
+
+void TextField::collectMemoryStats(MemoryStats & stats) const
+{
+    DisplayObject::collectMemoryStats(stats);
+
+    size_t bytes = sizeof(TextField) - sizeof(DisplayObject) + MemoryStats::stringBytes(_text)
+        + _htmlElements.capacity() * sizeof(HtmlElement*)
+        + _lines.capacity() * sizeof(LineInfo*) + _lines.size() * sizeof(LineInfo)
+        + _renderElements.capacity() * sizeof(TextRenderElement*);
+    for (auto &it : _htmlElements)
+        bytes += sizeof(HtmlElement) + MemoryStats::stringBytes(it->text);
+    for (auto &it : _renderElements)
+        bytes += sizeof(TextRenderElement) + MemoryStats::stringBytes(it->text);
+    if (_charPositions != nullptr)
+        bytes += sizeof(std::vector<CharPosition>) + _charPositions->capacity() * sizeof(CharPosition);
+    stats.add(MemoryStats::TEXT_LAYOUT, bytes);
+}
+
 const hkvVec2 & TextField::getTextSize()
 {
     if (_textChanged)
@@ -451,6 +485,14 @@ void TextField::onSizeChanged(bool widthChanged, bool heightChanged)
 }
 
 void TextField::buildLines()
+{
+    FGUI_PROFILE_ZONE("TextField::buildLines");
+    beginBuildLines();
+    layoutLines();
+    buildLinesFinal();
+}
+
+void TextField::beginBuildLines()
 {
     _textChanged = false;
     _requireUpdateMesh = true;
@@ -464,7 +506,10 @@ void TextField::buildLines()
         MyXmlVisitor visitor(this);
         xmlDoc.Accept(&visitor);
     }
+}
 
+void TextField::layoutLines()
+{
     if (_text.length() == 0 || _html && _htmlElements.size() == 0 || _font == nullptr)
     {
         LineInfo* emptyLine = new LineInfo();
@@ -474,9 +519,6 @@ void TextField::buildLines()
 
         _textBounds.set(0, 0);
         _fontSizeScale = 1;
-
-        buildLinesFinal();
-
         return;
     }
 
@@ -598,121 +640,21 @@ void TextField::buildLines()
             }
         }
 
-        float measureWidth = rectWidth - line->width - format->letterSpacing;
-        //from VTextState
-        // Wrap text into individual lines
-        const char *szCurrentLine = textBlock.c_str();
-        while (*szCurrentLine)
+        wrapText(_font, *format, textBlock.c_str(), wrap, _contentRect.GetSizeX(), line, startNewLine,
+            [&](const char* text, int length, int advance, const VRectanglef& rect)
         {
-            // byte offsets
-            int iByteOffsetAtWrapPosition;
-            int iByteOffsetAfterWrapPosition;
-
-            // search for next newline
-            const char *pNextNewLine = strchr(szCurrentLine, '\n');
-
-            // compute automatic wrap character index
-            int iCharCount;
-            if (wrap)
-                iCharCount = _font->getCharacterIndexAtPos(szCurrentLine, *format, measureWidth, -1);
-            else
-                iCharCount = strlen(szCurrentLine);
-            if (iCharCount == 0)
-            {
-                if (line->width > 0)
-                {
-                    measureWidth = _contentRect.GetSizeX();
-                    startNewLine();
-                    continue;
-                }
-                else
-                    iCharCount = 1;
-            }
-            int iWrapOffset = VString::GetUTF8CharacterOffset(szCurrentLine, iCharCount);
-
-            if (pNextNewLine != NULL && (pNextNewLine - szCurrentLine) <= iWrapOffset)
-            {
-                // newline occurs before automatic text wrap
-                iByteOffsetAtWrapPosition = static_cast<int>(pNextNewLine - szCurrentLine);
-                iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition + 1;
-            }
-            else if (strlen(szCurrentLine) <= static_cast<size_t>(iWrapOffset))
-            {
-                // End of text occurs before automatic text wrap
-                iByteOffsetAtWrapPosition = static_cast<int>(strlen(szCurrentLine));
-                iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition;
-            }
-            else
-            {
-                // automatic text wrap
-                iByteOffsetAtWrapPosition = iWrapOffset;
-
-                // Go backwards and try to find white space
-                while (iByteOffsetAtWrapPosition > 0 && !hkvStringUtils::IsWhiteSpace(szCurrentLine[iByteOffsetAtWrapPosition]))
-                {
-                    iByteOffsetAtWrapPosition--;
-                }
-
-                // no whitespace found? then wrap inside word
-                if (iByteOffsetAtWrapPosition == 0)
-                {
-                    iByteOffsetAtWrapPosition = iWrapOffset;
-                }
-                else
-                {
-                    // Find end of next word
-                    int iEndOfWord = iByteOffsetAtWrapPosition + 1;
-                    while (szCurrentLine[iEndOfWord] && !hkvStringUtils::IsWhiteSpace(szCurrentLine[iEndOfWord]))
-                    {
-                        iEndOfWord++;
-                    }
-
-                    // If the word does not fit into a line by itself, it will be wrapped anyway, so wrap it early to avoid ragged looking line endings
-                    VRectanglef nextWordSize;
-                    _font->getTextDimension(szCurrentLine + iByteOffsetAtWrapPosition, *format, nextWordSize, iEndOfWord - iByteOffsetAtWrapPosition);
-                    if (nextWordSize.GetSizeX() > measureWidth)
-                    {
-                        iByteOffsetAtWrapPosition = iWrapOffset;
-                    }
-                }
-                iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition;
-            }
-
-            // put together line
-            hkvStringView sView(szCurrentLine, szCurrentLine + iByteOffsetAtWrapPosition);
-            hkvStringBuilder sLine = sView;
-
-            VRectanglef rect(0, 0, 0, 0);
-            _font->getTextDimension(szCurrentLine, *format, rect, iByteOffsetAtWrapPosition);
-            float lineHeight = MAX(_font->getLineHeight(*format), rect.m_vMax.y);
-            if (lineHeight > line->textHeight)
-                line->textHeight = lineHeight;
-
-            if (lineHeight > line->height)
-                line->height = lineHeight;
-
-            if (line->width != 0)
-                line->width += format->letterSpacing;
-            line->width += (wrap ? MIN(rectWidth - line->width, rect.m_vMax.x) : rect.m_vMax.x);
-
             TextRenderElement* re = new TextRenderElement();
             re->element = nullptr;
             re->charIndex = charIndex;
             re->lineIndex = lineIndex;
             re->size.set(rect.m_vMax.x, _font->getLineHeight(*format));
-            re->text = std::string(szCurrentLine, iByteOffsetAtWrapPosition);
-            re->charCount = iByteOffsetAfterWrapPosition;
+            re->text = std::string(text, length);
+            re->charCount = advance;
             re->format = format;
             _renderElements.push_back(re);
 
             charIndex += re->charCount;
-
-            measureWidth = _contentRect.GetSizeX();
-            szCurrentLine = &szCurrentLine[iByteOffsetAfterWrapPosition];
-
-            if (*szCurrentLine || pNextNewLine)
-                startNewLine();
-        }
+        });
 
         elementIndex++;
         if (elementIndex >= elementCount)
@@ -754,8 +696,115 @@ void TextField::buildLines()
     }
     else
         _fontSizeScale = 1;
+}
 
-    buildLinesFinal();
+void TextField::wrapText(BaseFont* font, const TextFormat& format, const char* text, bool wrap, float width,
+    LineInfo*& line, const std::function<void()>& startNewLine, const SegmentCallback& onSegment)
+{
+    float rectWidth = width - GUTTER_X * 2;
+    float fontLineHeight = (float)font->getLineHeight(format);
+    float measureWidth = rectWidth - line->width - format.letterSpacing;
+    //from VTextState
+    // Wrap text into individual lines
+    const char *szCurrentLine = text;
+    while (*szCurrentLine)
+    {
+        // byte offsets
+        int iByteOffsetAtWrapPosition;
+        int iByteOffsetAfterWrapPosition;
+
+        // search for next newline
+        const char *pNextNewLine = strchr(szCurrentLine, '\n');
+
+        // compute automatic wrap character index
+        int iCharCount;
+        if (wrap)
+            iCharCount = font->getCharacterIndexAtPos(szCurrentLine, format, measureWidth, -1);
+        else
+            iCharCount = strlen(szCurrentLine);
+        if (iCharCount == 0)
+        {
+            if (line->width > 0)
+            {
+                measureWidth = width;
+                startNewLine();
+                continue;
+            }
+            else
+                iCharCount = 1;
+        }
+        int iWrapOffset = VString::GetUTF8CharacterOffset(szCurrentLine, iCharCount);
+
+        if (pNextNewLine != NULL && (pNextNewLine - szCurrentLine) <= iWrapOffset)
+        {
+            // newline occurs before automatic text wrap
+            iByteOffsetAtWrapPosition = static_cast<int>(pNextNewLine - szCurrentLine);
+            iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition + 1;
+        }
+        else if (strlen(szCurrentLine) <= static_cast<size_t>(iWrapOffset))
+        {
+            // End of text occurs before automatic text wrap
+            iByteOffsetAtWrapPosition = static_cast<int>(strlen(szCurrentLine));
+            iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition;
+        }
+        else
+        {
+            // automatic text wrap
+            iByteOffsetAtWrapPosition = iWrapOffset;
+
+            // Go backwards and try to find white space
+            while (iByteOffsetAtWrapPosition > 0 && !hkvStringUtils::IsWhiteSpace(szCurrentLine[iByteOffsetAtWrapPosition]))
+            {
+                iByteOffsetAtWrapPosition--;
+            }
+
+            // no whitespace found? then wrap inside word
+            if (iByteOffsetAtWrapPosition == 0)
+            {
+                iByteOffsetAtWrapPosition = iWrapOffset;
+            }
+            else
+            {
+                // Find end of next word
+                int iEndOfWord = iByteOffsetAtWrapPosition + 1;
+                while (szCurrentLine[iEndOfWord] && !hkvStringUtils::IsWhiteSpace(szCurrentLine[iEndOfWord]))
+                {
+                    iEndOfWord++;
+                }
+
+                // If the word does not fit into a line by itself, it will be wrapped anyway, so wrap it early to avoid ragged looking line endings
+                VRectanglef nextWordSize;
+                font->getTextDimension(szCurrentLine + iByteOffsetAtWrapPosition, format, nextWordSize, iEndOfWord - iByteOffsetAtWrapPosition);
+                if (nextWordSize.GetSizeX() > measureWidth)
+                {
+                    iByteOffsetAtWrapPosition = iWrapOffset;
+                }
+            }
+            iByteOffsetAfterWrapPosition = iByteOffsetAtWrapPosition;
+        }
+
+        VRectanglef rect(0, 0, 0, 0);
+        font->getTextDimension(szCurrentLine, format, rect, iByteOffsetAtWrapPosition);
+        float lineHeight = MAX(fontLineHeight, rect.m_vMax.y);
+        if (lineHeight > line->textHeight)
+            line->textHeight = lineHeight;
+
+        if (lineHeight > line->height)
+            line->height = lineHeight;
+
+        if (line->width != 0)
+            line->width += format.letterSpacing;
+        line->width += (wrap ? MIN(rectWidth - line->width, rect.m_vMax.x) : rect.m_vMax.x);
+
+        if (onSegment)
+            onSegment(szCurrentLine, iByteOffsetAtWrapPosition, iByteOffsetAfterWrapPosition, rect);
+
+        measureWidth = width;
+        szCurrentLine = &szCurrentLine[iByteOffsetAfterWrapPosition];
+
+        if (*szCurrentLine || pNextNewLine)
+            startNewLine();
+    }
 }
 
 void TextField::buildLinesFinal()
@@ -43,6 +43,7 @@ public:
     virtual void ensureSizeCorrect() override;
     virtual void onSizeChanged(bool widthChanged, bool heightChanged) override;
     virtual void update(float dt) override;
+    virtual void collectMemoryStats(MemoryStats& stats) const override;
 
     struct LineInfo
     {
@@ -68,11 +69,25 @@ protected:
     TextField();
     virtual ~TextField();
 
+    virtual VRectanglef getDrawRect() override;
+
 private:
     void resolveFont();
     void buildLines();
+    //buildLines in three steps for Stage::flushRebuilds. Only layoutLines may run on a worker
+    //thread, it measures with the font and writes nothing but the lines, render elements and bounds.
+    void beginBuildLines();
+    void layoutLines();
     void buildLinesFinal();
     void buildMesh();
+
+    typedef std::function<void(const char* text, int length, int advance, const VRectanglef& rect)> SegmentCallback;
+    //Wraps a block of plain text from the end of line on, for a field of the given width. The
+    //widths and heights of the lines are updated, startNewLine must move line to the next one.
+    //onSegment gets every piece placed on a line: its bytes, the bytes it consumes and its size.
+    //Shared by layoutLines and TextMeasurer.
+    static void wrapText(BaseFont* font, const TextFormat& format, const char* text, bool wrap, float width,
+        LineInfo*& line, const std::function<void()>& startNewLine, const SegmentCallback& onSegment);
     void applyVerticalAlign();
     void setInput();
     void cleanup();
@@ -106,6 +121,8 @@ private:
     friend class MyXmlVisitor;
     friend class RichTextField;
     friend class InputTextField;
+    friend class Stage;
+    friend class TextMeasurer;
 
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(TextField);
@@ -0,0 +1,182 @@
+#include "TextMeasurer.h"
+#include "BaseFont.h"
+#include "TextField.h"
+#include "FGUIManager.h"
+#include "UIConfig.h"
+
+NS_FGUI_BEGIN
+
+//same as TextField
+static const int GUTTER_X = 2;
+static const int GUTTER_Y = 2;
+
+TextMeasurer::TextMeasurer() :
+    _lastHandle(0),
+    _runningFont(nullptr),
+    _stopping(false)
+{
+}
+
+TextMeasurer::~TextMeasurer()
+{
+    if (_worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        _worker.join();
+    }
+
+    for (auto &it : _pendingJobs)
+        delete it;
+    _pendingJobs.clear();
+    for (auto &it : _finishedJobs)
+        delete it;
+    _finishedJobs.clear();
+    _callbacks.clear();
+}
+
+int TextMeasurer::measure(const std::string & text, const TextFormat & format, float width, const MeasureCallback & callback)
+{
+    std::string fontName = format.font;
+    if (fontName.empty())
+        fontName = UIConfig::defaultFont;
+
+    Job* job = new Job();
+    job->handle = ++_lastHandle;
+    job->text = text;
+    job->format = format;
+    job->font = FGUIManager::GlobalManager().getFontByName(fontName);
+    job->width = width;
+    _callbacks[job->handle] = callback;
+
+    if (!_worker.joinable())
+        _worker = std::thread(&TextMeasurer::workerMain, this);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingJobs.push_back(job);
+    }
+    _condition.notify_one();
+
+    return job->handle;
+}
+
+void TextMeasurer::cancel(int handle)
+{
+    //the job itself still runs, its result is dropped in update()
+    _callbacks.erase(handle);
+}
+
+void TextMeasurer::releaseFont(BaseFont * font)
+{
+    if (font == nullptr || !_worker.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (auto it = _pendingJobs.begin(); it != _pendingJobs.end();)
+    {
+        if ((*it)->font == font)
+        {
+            _callbacks.erase((*it)->handle);
+            delete *it;
+            it = _pendingJobs.erase(it);
+        }
+        else
+            ++it;
+    }
+    _jobDoneCondition.wait(lock, [this, font] { return _runningFont != font; });
+}
+
+void TextMeasurer::update()
+{
+    if (_callbacks.empty())
+        return;
+
+    std::deque<Job*> finishedJobs;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        finishedJobs.swap(_finishedJobs);
+    }
+
+    for (auto &it : finishedJobs)
+    {
+        auto it2 = _callbacks.find(it->handle);
+        if (it2 != _callbacks.end())
+        {
+            MeasureCallback callback = it2->second;
+            _callbacks.erase(it2);
+            callback(it->result);
+        }
+        delete it;
+    }
+}
+
+void TextMeasurer::workerMain()
+{
+    while (true)
+    {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _stopping || !_pendingJobs.empty(); });
+            if (_stopping)
+                return;
+
+            job = _pendingJobs.front();
+            _pendingJobs.pop_front();
+            _runningFont = job->font;
+        }
+
+        job->result = measureText(job->font, job->text, job->format, job->width);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finishedJobs.push_back(job);
+            _runningFont = nullptr;
+        }
+        _jobDoneCondition.notify_all();
+    }
+}
+
+hkvVec2 TextMeasurer::measureText(BaseFont * font, const std::string & text, const TextFormat & format, float width)
+{
+    if (text.empty() || font == nullptr)
+        return hkvVec2(0, 0);
+
+    //the plain text path of TextField::layoutLines, without the render elements
+    int lineSpacing = format.lineSpacing - 1;
+    float textWidth = 0;
+    float lastLineHeight = 0;
+    TextField::LineInfo line;
+    line.y = GUTTER_Y;
+    TextField::LineInfo* current = &line;
+
+    auto startNewLine = [&]()
+    {
+        if (line.width > textWidth)
+            textWidth = line.width;
+
+        if (line.height == 0)
+            line.height = lastLineHeight == 0 ? format.size : lastLineHeight;
+        lastLineHeight = line.height;
+
+        line.y += line.height + lineSpacing;
+        line.width = 0;
+        line.height = 0;
+        line.textHeight = 0;
+    };
+
+    TextField::wrapText(font, format, text.c_str(), width > 0, width, current, startNewLine, nullptr);
+
+    if (line.width > textWidth)
+        textWidth = line.width;
+    if (textWidth > 0)
+        textWidth += GUTTER_X * 2;
+
+    return hkvVec2(hkvMath::ceil(textWidth), hkvMath::ceil(line.y + line.height + GUTTER_Y));
+}
+
+NS_FGUI_END
@@ -0,0 +1,72 @@
+#ifndef __TEXTMEASURER_H__
+#define __TEXTMEASURER_H__
+
+#include "FGUIMacros.h"
+#include "TextFormat.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+NS_FGUI_BEGIN
+
+class BaseFont;
+
+//Measures plain text on a worker thread, so the size of text that is not displayed yet
+//(e.g. rows of a virtual list below the view) can be known before it is rendered.
+//The font is resolved on the main thread when the request is made, the result is
+//delivered in update() on the main thread. HTML/UBB text is not supported.
+class FGUI_IMPEXP TextMeasurer
+{
+public:
+    typedef std::function<void(const hkvVec2&)> MeasureCallback;
+
+    TextMeasurer();
+    ~TextMeasurer();
+
+    //Measures text as a word wrapped TextField of the given width would lay it out,
+    //width <= 0 means no wrapping. Returns a handle which can be passed to cancel().
+    int measure(const std::string& text, const TextFormat& format, float width, const MeasureCallback& callback);
+    void cancel(int handle);
+    //Drops the jobs that measure with the font and waits for a running one to finish.
+    //Must be called before a font that was passed to the worker is deleted.
+    void releaseFont(BaseFont* font);
+
+    void update();
+
+    int getPendingCount() const { return (int)_callbacks.size(); }
+
+    //Same measurement done on the calling thread. The result is the text bounds of
+    //TextField::buildLines, gutters included.
+    static hkvVec2 measureText(BaseFont* font, const std::string& text, const TextFormat& format, float width);
+
+private:
+    struct Job
+    {
+        int handle;
+        std::string text;
+        TextFormat format;
+        BaseFont* font;
+        float width;
+        hkvVec2 result;
+    };
+
+    void workerMain();
+
+    std::unordered_map<int, MeasureCallback> _callbacks;
+    int _lastHandle;
+
+    std::thread _worker;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _jobDoneCondition;
+    BaseFont* _runningFont;
+    std::deque<Job*> _pendingJobs;
+    std::deque<Job*> _finishedJobs;
+    bool _stopping;
+};
+
+NS_FGUI_END
+
+#endif
@@ -0,0 +1,325 @@
+#include "TextureCache.h"
+#include "NTexture.h"
+#include "DynamicAtlas.h"
+#include "UIConfig.h"
+
+#include <algorithm>
+
+NS_FGUI_BEGIN
+
+static const int WORKER_COUNT = 2;
+
+//Image_cl keeps the color and the opacity of an image apart, textures want them interleaved
+static bool decodeImage(IVFileInStream* stream, std::vector<VColorRef>& pixels, int& width, int& height)
+{
+    Image_cl image;
+    if (image.Load(stream) != VERR_NOERROR || !image.HasColorMap())
+        return false;
+
+    width = image.GetWidth();
+    height = image.GetHeight();
+    const UBYTE* color = image.GetColorMap();
+    const UBYTE* opacity = image.HasOpacityMap() ? image.GetOpacityMap() : nullptr;
+    if (width <= 0 || height <= 0 || color == nullptr)
+        return false;
+
+    int count = width * height;
+    pixels.resize(count);
+    for (int i = 0; i < count; i++, color += 3)
+        pixels[i] = VColorRef(color[0], color[1], color[2], opacity ? opacity[i] : 255);
+
+    return true;
+}
+
+TextureCache::TextureCache() :
+    _atlas(new DynamicAtlas()),
+    _totalBytes(0),
+    _useCounter(0),
+    _lastHandle(0),
+    _hitCount(0),
+    _missCount(0),
+    _stopping(false)
+{
+}
+
+TextureCache::~TextureCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto &it : _workers)
+        it.join();
+    _workers.clear();
+
+    //every job is in _jobs until it is finished on the main thread
+    for (auto &it : _jobs)
+        delete it.second;
+    _jobs.clear();
+    _pendingJobs.clear();
+    _finishedJobs.clear();
+
+    for (auto &it : _entries)
+        releaseEntry(it.second);
+    _entries.clear();
+
+    CC_SAFE_DELETE(_atlas);
+}
+
+int TextureCache::load(const std::string & url, const LoadCallback & callback)
+{
+    auto it = _entries.find(url);
+    if (it != _entries.end())
+    {
+        _hitCount++;
+        it->second.lastUse = ++_useCounter;
+        callback(it->second.texture);
+        return 0;
+    }
+
+    Waiter waiter;
+    waiter.handle = ++_lastHandle;
+    waiter.callback = callback;
+
+    auto it2 = _jobs.find(url);
+    if (it2 != _jobs.end())
+    {
+        it2->second->waiters.push_back(waiter);
+        return waiter.handle;
+    }
+
+    _missCount++;
+
+    Job* job = new Job();
+    job->url = url;
+    job->width = 0;
+    job->height = 0;
+    job->waiters.push_back(waiter);
+    _jobs[url] = job;
+
+    if (_workers.empty())
+        startWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingJobs.push_back(job);
+    }
+    _condition.notify_one();
+
+    return waiter.handle;
+}
+
+void TextureCache::cancel(int handle)
+{
+    for (auto &it : _jobs)
+    {
+        std::vector<Waiter>& waiters = it.second->waiters;
+        for (auto it2 = waiters.begin(); it2 != waiters.end(); ++it2)
+        {
+            if (it2->handle == handle)
+            {
+                waiters.erase(it2);
+                return;
+            }
+        }
+    }
+}
+
+void TextureCache::update()
+{
+    if (!_jobs.empty())
+    {
+        std::deque<Job*> finishedJobs;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            finishedJobs.swap(_finishedJobs);
+        }
+
+        for (auto &it : finishedJobs)
+            finishJob(it);
+    }
+
+    trim();
+}
+
+int TextureCache::getTotalBytes() const
+{
+    return _totalBytes + _atlas->getTotalBytes();
+}
+
+void TextureCache::purge()
+{
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.texture->getReferenceCount() == 1)
+        {
+            releaseEntry(it->second);
+            it = _entries.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    _atlas->compact();
+}
+
+void TextureCache::startWorkers()
+{
+    for (int i = 0; i < WORKER_COUNT; i++)
+        _workers.push_back(std::thread(&TextureCache::workerMain, this));
+}
+
+void TextureCache::workerMain()
+{
+    while (true)
+    {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _stopping || !_pendingJobs.empty(); });
+            if (_stopping)
+                return;
+
+            job = _pendingJobs.front();
+            _pendingJobs.pop_front();
+        }
+
+        //The file is read and decoded here, the main thread only creates or fills the texture.
+        IVFileInStream* stream = VFileAccessManager::GetInstance()->Open(job->url.c_str());
+        if (stream != nullptr)
+        {
+            if (!decodeImage(stream, job->pixels, job->width, job->height))
+                job->pixels.clear();
+            stream->Close();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finishedJobs.push_back(job);
+        }
+    }
+}
+
+void TextureCache::finishJob(Job * job)
+{
+    _jobs.erase(job->url);
+
+    //Decoded images are copied into the atlas when they fit, otherwise their pixels become
+    //a texture of their own. Only images the decoder cannot read (compressed DDS and the
+    //like) are left to the texture manager, which loads them on this thread.
+    NTexture* texture = nullptr;
+    int bytes = 0;
+    if (!job->pixels.empty())
+    {
+        int maxSize = UIConfig::dynamicAtlasMaxTextureSize;
+        if (maxSize > 0 && job->width <= maxSize && job->height <= maxSize)
+            texture = packTexture(job->pixels.data(), job->width, job->height);
+        if (texture == nullptr)
+        {
+            texture = createTexture(job->url, job->pixels.data(), job->width, job->height);
+            if (texture != nullptr)
+                bytes = job->width * job->height * 4;
+        }
+    }
+    else
+    {
+        VTextureObject* tex = Vision::TextureManager.Load2DTexture(job->url.c_str(), VTM_FLAG_DEFAULT_NON_MIPMAPPED);
+        if (tex)
+        {
+            texture = new NTexture(tex);
+            bytes = tex->GetTextureWidth() * tex->GetTextureHeight() * 4;
+        }
+    }
+
+    if (texture != nullptr)
+    {
+        Entry entry;
+        entry.texture = texture;
+        entry.bytes = bytes;
+        entry.lastUse = ++_useCounter;
+        _entries[job->url] = entry;
+        _totalBytes += entry.bytes;
+    }
+    else
+        CCLOGWARN("FairyGUI: cannot load texture '%s'", job->url.c_str());
+
+    for (auto &it : job->waiters)
+        it.callback(texture);
+
+    delete job;
+}
+
+NTexture * TextureCache::packTexture(const VColorRef* pixels, int width, int height)
+{
+    NTexture* texture = _atlas->pack(pixels, width, height);
+    if (texture == nullptr && evictPacked())
+        texture = _atlas->pack(pixels, width, height);
+
+    return texture;
+}
+
+NTexture * TextureCache::createTexture(const std::string& url, const VColorRef* pixels, int width, int height)
+{
+    VTextureObject* tex = Vision::TextureManager.Create2DTextureObject(url.c_str(), width, height, 1, VTextureLoader::R8G8B8A8);
+    if (tex == nullptr)
+        return nullptr;
+
+    tex->UpdateRect(0, 0, 0, width, height, width * sizeof(VColorRef), pixels, 0);
+    return new NTexture(tex);
+}
+
+bool TextureCache::evictPacked()
+{
+    bool evicted = false;
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.texture->getReferenceCount() == 1 && _atlas->isPacked(it->second.texture))
+        {
+            releaseEntry(it->second);
+            it = _entries.erase(it);
+            evicted = true;
+        }
+        else
+            ++it;
+    }
+
+    return evicted;
+}
+
+void TextureCache::releaseEntry(Entry & entry)
+{
+    _totalBytes -= entry.bytes;
+    _atlas->free(entry.texture);
+    entry.texture->release();
+}
+
+void TextureCache::trim()
+{
+    if (UIConfig::externalTextureCacheSize <= 0 || getTotalBytes() <= UIConfig::externalTextureCacheSize)
+        return;
+
+    std::vector<std::pair<unsigned int, std::string>> unused;
+    for (auto &it : _entries)
+    {
+        if (it.second.texture->getReferenceCount() == 1)
+            unused.push_back(std::make_pair(it.second.lastUse, it.first));
+    }
+    std::sort(unused.begin(), unused.end());
+
+    for (auto &it : unused)
+    {
+        if (getTotalBytes() <= UIConfig::externalTextureCacheSize)
+            break;
+
+        auto it2 = _entries.find(it.second);
+        bool packed = _atlas->isPacked(it2->second.texture);
+        releaseEntry(it2->second);
+        _entries.erase(it2);
+        //a page only gives its bytes back once the last region on it is gone
+        if (packed)
+            _atlas->compact();
+    }
+}
+
+NS_FGUI_END
@@ -0,0 +1,97 @@
+#ifndef __TEXTURECACHE_H__
+#define __TEXTURECACHE_H__
+
+#include "FGUIMacros.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+NS_FGUI_BEGIN
+
+class NTexture;
+class DynamicAtlas;
+
+//Loads external textures by url. Files are read and decoded on worker threads, the
+//texture is created and filled on the main thread in update(). Textures are shared by url and kept in an
+//LRU list; an entry is only dropped when nobody else holds its NTexture and the
+//cache is over UIConfig::externalTextureCacheSize bytes. Images no larger than
+//UIConfig::dynamicAtlasMaxTextureSize are copied into the DynamicAtlas instead of
+//getting a texture of their own. Their bytes are those of the atlas pages, which
+//count towards the cache size with the textures.
+class FGUI_IMPEXP TextureCache
+{
+public:
+    typedef std::function<void(NTexture*)> LoadCallback;
+
+    TextureCache();
+    ~TextureCache();
+
+    //returns 0 when the callback was already called synchronously,
+    //otherwise a handle which can be passed to cancel()
+    int load(const std::string& url, const LoadCallback& callback);
+    void cancel(int handle);
+
+    void update();
+    void purge();
+
+    int getTextureCount() const { return (int)_entries.size(); }
+    int getTotalBytes() const;
+    int getHitCount() const { return _hitCount; }
+    int getMissCount() const { return _missCount; }
+    DynamicAtlas* getDynamicAtlas() const { return _atlas; }
+
+private:
+    struct Entry
+    {
+        NTexture* texture;
+        int bytes;
+        unsigned int lastUse;
+    };
+
+    struct Waiter
+    {
+        int handle;
+        LoadCallback callback;
+    };
+
+    struct Job
+    {
+        std::string url;
+        std::vector<Waiter> waiters;
+        //decoded by the worker, empty when the image could not be decoded
+        std::vector<VColorRef> pixels;
+        int width;
+        int height;
+    };
+
+    void startWorkers();
+    void workerMain();
+    void finishJob(Job* job);
+    NTexture* packTexture(const VColorRef* pixels, int width, int height);
+    NTexture* createTexture(const std::string& url, const VColorRef* pixels, int width, int height);
+    bool evictPacked();
+    void releaseEntry(Entry& entry);
+    void trim();
+
+    std::unordered_map<std::string, Entry> _entries;
+    std::unordered_map<std::string, Job*> _jobs;
+    DynamicAtlas* _atlas;
+    int _totalBytes;
+    unsigned int _useCounter;
+    int _lastHandle;
+    int _hitCount;
+    int _missCount;
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Job*> _pendingJobs;
+    std::deque<Job*> _finishedJobs;
+    bool _stopping;
+};
+
+NS_FGUI_END
+
+#endif
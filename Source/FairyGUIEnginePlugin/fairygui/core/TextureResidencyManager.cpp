@@ -0,0 +1,119 @@
+#include "TextureResidencyManager.h"
+#include "NTexture.h"
+#include "UIConfig.h"
+
+#include <algorithm>
+
+NS_FGUI_BEGIN
+
+TextureResidencyManager::TextureResidencyManager() :
+    _time(0),
+    _residentBytes(0),
+    _evictionCount(0),
+    _reloadCount(0)
+{
+}
+
+TextureResidencyManager::~TextureResidencyManager()
+{
+}
+
+void TextureResidencyManager::addTexture(NTexture * texture)
+{
+    if (texture->getNativeTexture() == nullptr)
+        return;
+
+    texture->lastActive = _time;
+    _textures.push_back(texture);
+    _residentBytes += getTextureBytes(texture);
+}
+
+void TextureResidencyManager::removeTexture(NTexture * texture)
+{
+    auto it = std::find(_textures.begin(), _textures.end(), texture);
+    if (it != _textures.end())
+    {
+        if (texture->getNativeTexture()->IsLoaded())
+            _residentBytes -= getTextureBytes(texture);
+        _textures.erase(it);
+    }
+}
+
+void TextureResidencyManager::touch(NTexture * texture)
+{
+    NTexture* root = texture->getRoot();
+    if (root->lastActive == _time)
+        return;
+
+    root->lastActive = _time;
+
+    VTextureObject* nativeTexture = root->getNativeTexture();
+    if (nativeTexture != nullptr && !nativeTexture->IsLoaded())
+    {
+        nativeTexture->EnsureLoaded();
+        _reloadCount++;
+        _residentBytes += getTextureBytes(root);
+    }
+}
+
+void TextureResidencyManager::update(float time)
+{
+    //textures drawn in the last frame carry the previous time stamp, they are never evicted
+    float lastFrameTime = _time;
+    _time = time;
+
+    if (UIConfig::textureIdleTimeout > 0)
+    {
+        for (auto &it : _textures)
+        {
+            if (it->getNativeTexture()->IsLoaded() && it->lastActive < lastFrameTime
+                && time - it->lastActive > UIConfig::textureIdleTimeout)
+                evict(it);
+        }
+    }
+
+    if (UIConfig::textureMemoryBudget > 0 && _residentBytes > UIConfig::textureMemoryBudget)
+    {
+        _candidates.clear();
+        for (auto &it : _textures)
+        {
+            if (it->getNativeTexture()->IsLoaded() && it->lastActive < lastFrameTime)
+                _candidates.push_back(it);
+        }
+        std::sort(_candidates.begin(), _candidates.end(),
+            [](NTexture* a, NTexture* b) { return a->lastActive < b->lastActive; });
+
+        for (auto &it : _candidates)
+        {
+            if (_residentBytes <= UIConfig::textureMemoryBudget)
+                break;
+            evict(it);
+        }
+        _candidates.clear();
+    }
+}
+
+void TextureResidencyManager::evictAll()
+{
+    for (auto &it : _textures)
+    {
+        if (it->getNativeTexture()->IsLoaded())
+            evict(it);
+    }
+}
+
+void TextureResidencyManager::evict(NTexture * texture)
+{
+    _residentBytes -= getTextureBytes(texture);
+    _evictionCount++;
+    texture->getNativeTexture()->EnsureUnloaded();
+}
+
+int TextureResidencyManager::getTextureBytes(NTexture * texture)
+{
+    //atlases are loaded as 32 bit textures without mipmaps
+    VTextureObject* nativeTexture = texture->getNativeTexture();
+    return nativeTexture->GetTextureWidth() * nativeTexture->GetTextureHeight() * 4;
+}
+
+NS_FGUI_END
@@ -0,0 +1,46 @@
+#ifndef __TEXTURERESIDENCYMANAGER_H__
+#define __TEXTURERESIDENCYMANAGER_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+class NTexture;
+
+//Unloads the native textures of atlases that have not been drawn for a while,
+//or the least recently drawn ones when over the memory budget (see UIConfig).
+//An evicted atlas is reloaded the next time anything using it is drawn.
+class FGUI_IMPEXP TextureResidencyManager
+{
+public:
+    TextureResidencyManager();
+    ~TextureResidencyManager();
+
+    void addTexture(NTexture* texture);
+    void removeTexture(NTexture* texture);
+
+    void touch(NTexture* texture);
+    void update(float time);
+    void evictAll();
+
+    int getTextureCount() const { return (int)_textures.size(); }
+    int getResidentBytes() const { return _residentBytes; }
+    int getEvictionCount() const { return _evictionCount; }
+    int getReloadCount() const { return _reloadCount; }
+
+    static int getTextureBytes(NTexture* texture);
+
+private:
+    void evict(NTexture* texture);
+
+    std::vector<NTexture*> _textures;
+    std::vector<NTexture*> _candidates;
+    float _time;
+    int _residentBytes;
+    int _evictionCount;
+    int _reloadCount;
+};
+
+NS_FGUI_END
+
+#endif
@@ -4,6 +4,7 @@
 #include "FGUIMacros.h"
 #include "EventContext.h"
 #include "UIEventType.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
@@ -42,6 +43,8 @@ class Node;
 class FGUI_IMPEXP EventDispatcher : public Ref
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     EventDispatcher();
     virtual ~EventDispatcher();
 
@@ -58,6 +61,7 @@ public:
     bool bubbleEvent(int eventType, void* data = nullptr, const Value& dataValue = Value::Null);
 
     bool isDispatchingEvent(int eventType);
+    size_t getListenerMemoryUsage() const;
 
     EventDispatcher* getSpectator() const { return _spectator; }
     void setSpectator(EventDispatcher* value) { _spectator = value; }
@@ -70,6 +74,8 @@ private:
 
     struct EventCallbackItem
     {
+        FGUI_SLAB_ALLOCATED
+
         EventCallback callback;
         int eventType;
         EventTag tag;
@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -78,4 +79,9 @@ void GearAnimation::updateState()
     _storage[_controller->getSelectedPageId()] = GearAnimationValue(ag->isPlaying(), ag->getCurrentFrame());
 }
 
+size_t GearAnimation::getMemoryUsage() const
+{
+    return sizeof(GearAnimation) + MemoryStats::mapBytes(_storage);
+}
+
 NS_FGUI_END
\ No newline at end of file
@@ -47,6 +47,11 @@ void GearBase::updateState()
 {
 }
 
+size_t GearBase::getMemoryUsage() const
+{
+    return sizeof(GearBase);
+}
+
 void GearBase::updateFromRelations(float dx, float dy)
 {
 }
@@ -3,6 +3,7 @@
 
 #include "FGUIMacros.h"
 #include "third_party/cc/CCTweenFunction.h"
+#include "utils/SlabAllocator.h"
 
 NS_FGUI_BEGIN
 
@@ -12,6 +13,8 @@ class GController;
 class FGUI_IMPEXP GearBase
 {
 public:
+    FGUI_SLAB_ALLOCATED
+
     GearBase(GObject* owner);
     virtual ~GearBase();
 
@@ -21,6 +24,7 @@ public:
     virtual void updateFromRelations(float dx, float dy);
     virtual void apply();
     virtual void updateState();
+    virtual size_t getMemoryUsage() const;
 
     void setup(TXMLElement * xml);
 
@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -137,4 +138,9 @@ void GearColor::updateState()
     _storage[_controller->getSelectedPageId()] = GearColorValue(cg->getColor(), cg->getOutlineColor());
 }
 
+size_t GearColor::getMemoryUsage() const
+{
+    return sizeof(GearColor) + MemoryStats::mapBytes(_storage);
+}
+
 NS_FGUI_END
\ No newline at end of file
@@ -27,6 +27,7 @@ public:
 
     void apply() override;
     void updateState() override;
+    size_t getMemoryUsage() const override;
 
 protected:
     void addStatus(const std::string&  pageId, const std::string& value) override;
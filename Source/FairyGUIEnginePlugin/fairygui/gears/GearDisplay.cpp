@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -33,6 +34,14 @@ void GearDisplay::updateState()
 {
 }
 
+size_t GearDisplay::getMemoryUsage() const
+{
+    size_t bytes = sizeof(GearDisplay) + pages.capacity() * sizeof(std::string);
+    for (auto &it : pages)
+        bytes += MemoryStats::stringBytes(it);
+    return bytes;
+}
+
 void GearDisplay::addStatus(const std::string&  pageId, const std::string& value)
 {
 }
@@ -17,6 +17,7 @@ public:
 
     void apply() override;
     void updateState() override;
+    size_t getMemoryUsage() const override;
 
     UINT32 addLock();
     void releaseLock(UINT32 token);
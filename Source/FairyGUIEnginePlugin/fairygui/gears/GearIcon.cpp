@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -48,4 +49,12 @@ void GearIcon::updateState()
     _storage[_controller->getSelectedPageId()] = _owner->getIcon();
 }
 
+size_t GearIcon::getMemoryUsage() const
+{
+    size_t bytes = sizeof(GearIcon) + MemoryStats::mapBytes(_storage);
+    for (auto &it : _storage)
+        bytes += MemoryStats::stringBytes(it.second);
+    return bytes;
+}
+
 NS_FGUI_END
\ No newline at end of file
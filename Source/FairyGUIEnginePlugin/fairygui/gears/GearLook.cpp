@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -132,5 +133,10 @@ void GearLook::updateState()
         _owner->isGrayed(), _owner->isTouchable());
 }
 
+size_t GearLook::getMemoryUsage() const
+{
+    return sizeof(GearLook) + MemoryStats::mapBytes(_storage);
+}
+
 
 NS_FGUI_END
\ No newline at end of file
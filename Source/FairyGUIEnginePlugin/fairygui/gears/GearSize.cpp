@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -110,6 +111,11 @@ void GearSize::updateState()
         _owner->getScaleX(), _owner->getScaleY());
 }
 
+size_t GearSize::getMemoryUsage() const
+{
+    return sizeof(GearSize) + MemoryStats::mapBytes(_storage);
+}
+
 void GearSize::updateFromRelations(float dx, float dy)
 {
     if (_controller != nullptr && !_storage.empty())
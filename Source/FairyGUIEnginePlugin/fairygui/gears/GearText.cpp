@@ -4,11 +4,13 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
 
-GearText::GearText(GObject * owner) :GearBase(owner)
+GearText::GearText(GObject * owner) :GearBase(owner),
+    _hasDefault(false)
 {
 
 }
@@ -21,14 +23,41 @@ void GearText::init()
 {
     _default = _owner->getText();
     _storage.clear();
+    _pages.clear();
+    _hasDefault = false;
 }
 
 void GearText::addStatus(const std::string&  pageId, const std::string& value)
 {
     if (pageId.length() == 0)
+    {
         _default = value;
+        _hasDefault = true;
+    }
     else
+    {
         _storage[pageId] = value;
+        _pages.push_back(pageId);
+    }
+}
+
+void GearText::applyStrings(const StringTable & strings, int componentId, int elementId)
+{
+    const char* p = strings.find(componentId, elementId, StringTable::TEXTS);
+    if (p)
+    {
+        std::vector<std::string> values;
+        ToolSet::splitString(p, '|', values);
+
+        int cnt = (int)values.size();
+        for (int i = 0; i < (int)_pages.size(); i++)
+            _storage[_pages[i]] = i < cnt ? values[i] : STD_STRING_EMPTY;
+    }
+
+    //without a default of its own the gear falls back to the text the owner was created with
+    p = strings.find(componentId, elementId, _hasDefault ? StringTable::TEXTS_DEF : StringTable::TEXT);
+    if (p)
+        _default = p;
 }
 
 void GearText::apply()
@@ -49,4 +78,12 @@ void GearText::updateState()
     _storage[_controller->getSelectedPageId()] = _owner->getText();
 }
 
+size_t GearText::getMemoryUsage() const
+{
+    size_t bytes = sizeof(GearText) + MemoryStats::mapBytes(_storage);
+    for (auto &it : _storage)
+        bytes += MemoryStats::stringBytes(it.second);
+    return bytes;
+}
+
 NS_FGUI_END
\ No newline at end of file
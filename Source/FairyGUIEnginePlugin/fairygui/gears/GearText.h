@@ -8,6 +8,7 @@
 NS_FGUI_BEGIN
 
 class GObject;
+class StringTable;
 
 class FGUI_IMPEXP GearText : public GearBase
 {
@@ -17,6 +18,11 @@ public:
 
     void apply() override;
     void updateState() override;
+    size_t getMemoryUsage() const override;
+
+    //replaces the page values and the default with the strings of the element, see UIPackage::setStringsSource;
+    //the owner is left as it is until the next apply()
+    void applyStrings(const StringTable& strings, int componentId, int elementId);
 
 protected:
     void addStatus(const std::string&  pageId, const std::string& value) override;
@@ -25,6 +31,8 @@ protected:
 private:
     std::unordered_map<std::string, std::string> _storage;
     std::string _default;
+    std::vector<std::string> _pages;
+    bool _hasDefault;
 };
 
 NS_FGUI_END
@@ -4,6 +4,7 @@
 #include "GController.h"
 #include "utils/ToolSet.h"
 #include "utils/ActionUtils.h"
+#include "utils/MemoryStats.h"
 
 NS_FGUI_BEGIN
 
@@ -102,6 +103,11 @@ void GearXY::updateState()
     _storage[_controller->getSelectedPageId()] = hkvVec2(_owner->getX(), _owner->getY());
 }
 
+size_t GearXY::getMemoryUsage() const
+{
+    return sizeof(GearXY) + MemoryStats::mapBytes(_storage);
+}
+
 void GearXY::updateFromRelations(float dx, float dy)
 {
     if (_controller != nullptr && !_storage.empty())
@@ -17,6 +17,7 @@ public:
 
     void apply() override;
     void updateState() override;
+    size_t getMemoryUsage() const override;
     void updateFromRelations(float dx, float dy) override;
 
 protected:
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "CCScheduler.h"
 #include "ccMacros.h"
+#include "utils/Profiler.h"
 //#include "base/CCDirector.h"
 #include "utlist.h"
 #include "ccCArray.h"
@@ -169,6 +170,7 @@ bool TimerTargetSelector::initWithSelector(Scheduler* scheduler, SEL_SCHEDULE se
 
 void TimerTargetSelector::trigger(float dt)
 {
+    FGUI_PROFILE_COUNT(TIMERS_FIRED, 1);
     if (_target && _selector)
     {
         (_target->*_selector)(dt);
@@ -200,6 +202,7 @@ bool TimerTargetCallback::initWithCallback(Scheduler* scheduler, const ccSchedul
 
 void TimerTargetCallback::trigger(float dt)
 {
+    FGUI_PROFILE_COUNT(TIMERS_FIRED, 1);
     if (_callback)
     {
         _callback(dt);
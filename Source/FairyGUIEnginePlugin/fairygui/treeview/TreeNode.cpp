@@ -26,6 +26,9 @@ TreeNode::TreeNode() :
     _parent(nullptr),
     _cell(nullptr),
     _level(0),
+    _visibleCount(0),
+    _childRowsDirty(false),
+    _childIndex(0),
     _expanded(false),
     _isFolder(false),
     _isRootNode(false)
@@ -65,6 +68,8 @@ void TreeNode::setExpaned(bool value)
             else
                 _root->afterCollapsed(this);
         }
+        else
+            updateVisibleCount();
     }
 }
 
@@ -100,14 +105,25 @@ TreeNode* TreeNode::addChildAt(TreeNode* child, int index)
 
         int cnt = (int)_children.size();
         if (index == cnt)
+        {
             _children.pushBack(child);
+            appendChildRows(child);
+        }
         else
+        {
             _children.insert(index, child);
+            _childRowsDirty = true;
+        }
         child->release();
 
         child->_level = _level + 1;
+        bool shown = addVisibleRows(child->getRowCount());
+        bool virtualRows = _root != nullptr && _root->isVirtual();
+        //before setRoot, which may call treeNodeWillExpand and fill the child
+        if (virtualRows && shown)
+            _root->insertRows(child);
         child->setRoot(_root);
-        if (_isRootNode || (_cell != nullptr && _cell->getParent() != nullptr && _expanded))
+        if (!virtualRows && (_isRootNode || (_cell != nullptr && _cell->getParent() != nullptr && _expanded)))
             _root->afterInserted(child);
     }
     return child;
@@ -125,8 +141,18 @@ void TreeNode::removeChild(TreeNode* child)
 void TreeNode::removeChildAt(int index)
 {
     TreeNode* child = _children.at(index);
+    int rowIndex = -1;
+    if (_root != nullptr && _root->isVirtual() && _root->isChildrenShown(this))
+        rowIndex = _root->getRowIndex(child);
+    addVisibleRows(-child->getRowCount());
     child->_parent = nullptr;
     _children.erase(index);
+    if (index == (int)_children.size() && !_childRowsDirty)
+        _childRows.pop_back();
+    else
+        _childRowsDirty = true;
+    if (rowIndex != -1)
+        _root->removeRows(rowIndex, child->getRowCount());
 
     if (_root != nullptr)
     {
@@ -212,6 +238,9 @@ int TreeNode::moveChild(TreeNode* child, int oldIndex, int index)
     if (oldIndex == index)
         return oldIndex;
 
+    bool virtualRows = _root != nullptr && _root->isVirtual() && _root->isChildrenShown(this);
+    int rowIndex = virtualRows ? _root->getRowIndex(child) : -1;
+
     child->retain();
     _children.erase(oldIndex);
     if (index >= cnt)
@@ -219,7 +248,13 @@ int TreeNode::moveChild(TreeNode* child, int oldIndex, int index)
     else
         _children.insert(index, child);
     child->release();
-    if (_cell != nullptr && _cell->getParent() != nullptr && _expanded)
+    _childRowsDirty = true;
+    if (virtualRows)
+    {
+        _root->removeRows(rowIndex, child->getRowCount());
+        _root->insertRows(child);
+    }
+    else if (_cell != nullptr && _cell->getParent() != nullptr && _expanded)
         _root->afterMoved(child);
 
     return index;
@@ -269,6 +304,97 @@ void TreeNode::setRoot(TreeView* value)
     }
 }
 
+bool TreeNode::addVisibleRows(int delta)
+{
+    //the rows count towards every expanded ancestor, they are on screen if that reaches the root
+    TreeNode* node = this;
+    while (node->_expanded)
+    {
+        node->_visibleCount += delta;
+        if (node->_isRootNode)
+            return true;
+        TreeNode* parent = node->_parent;
+        if (parent == nullptr)
+            break;
+        parent->updateChildRows(node, delta);
+        node = parent;
+    }
+    return false;
+}
+
+void TreeNode::updateVisibleCount()
+{
+    int count = 0;
+    if (_expanded)
+    {
+        for (auto &child : _children)
+            count += child->getRowCount();
+    }
+
+    int delta = count - _visibleCount;
+    _visibleCount = count;
+    if (delta != 0 && _parent != nullptr)
+    {
+        _parent->updateChildRows(this, delta);
+        _parent->addVisibleRows(delta);
+    }
+}
+
+int TreeNode::getChildRowOffset(const TreeNode* child)
+{
+    if (_childRowsDirty)
+        rebuildChildRows();
+    return sumChildRows(child->_childIndex);
+}
+
+void TreeNode::appendChildRows(TreeNode* child)
+{
+    if (_childRowsDirty)
+        return;
+
+    //the new entry covers itself and the entries below it in its Fenwick range
+    int j = (int)_childRows.size() + 1;
+    child->_childIndex = j - 1;
+    _childRows.push_back(child->getRowCount() + sumChildRows(j - 1) - sumChildRows(j - (j & -j)));
+}
+
+void TreeNode::updateChildRows(const TreeNode* child, int delta)
+{
+    if (_childRowsDirty)
+        return;
+
+    int cnt = (int)_childRows.size();
+    for (int j = child->_childIndex + 1; j <= cnt; j += j & -j)
+        _childRows[j - 1] += delta;
+}
+
+void TreeNode::rebuildChildRows()
+{
+    int cnt = (int)_children.size();
+    _childRows.resize(cnt);
+    for (int i = 0; i < cnt; i++)
+    {
+        TreeNode* child = _children.at(i);
+        child->_childIndex = i;
+        _childRows[i] = child->getRowCount();
+    }
+    for (int j = 1; j <= cnt; j++)
+    {
+        int k = j + (j & -j);
+        if (k <= cnt)
+            _childRows[k - 1] += _childRows[j - 1];
+    }
+    _childRowsDirty = false;
+}
+
+int TreeNode::sumChildRows(int count) const
+{
+    int sum = 0;
+    for (int j = count; j > 0; j -= j & -j)
+        sum += _childRows[j - 1];
+    return sum;
+}
+
 void TreeNode::setCell(GComponent* value)
 {
     if (_cell != value)
@@ -53,11 +53,25 @@ private:
     int moveChild(TreeNode* child, int oldIndex, int index);
     void setRoot(TreeView* value);
     void setCell(GComponent* value);
+    int getRowCount() const { return 1 + _visibleCount; }
+    bool addVisibleRows(int delta);
+    void updateVisibleCount();
+    int getChildRowOffset(const TreeNode* child);
+    void appendChildRows(TreeNode* child);
+    void updateChildRows(const TreeNode* child, int delta);
+    void rebuildChildRows();
+    int sumChildRows(int count) const;
 
     TreeView* _root;
     TreeNode* _parent;
     GComponent* _cell;
     int _level;
+    int _visibleCount;
+    //Fenwick tree over the row counts of the children, the rows before a child are summed
+    //in O(log n). Rebuilt when children are inserted or removed anywhere but at the end.
+    std::vector<int> _childRows;
+    bool _childRowsDirty;
+    int _childIndex;
     bool _expanded;
     bool _isFolder;
     bool _isRootNode;
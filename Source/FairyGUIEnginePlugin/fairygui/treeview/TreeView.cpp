@@ -6,6 +6,8 @@
 
 NS_FGUI_BEGIN
 
+static const char* COMMIT_ROWS_KEY = "TreeView::commitRows";
+
 
 TreeView * TreeView::create(GList * list)
 {
@@ -26,12 +28,24 @@ TreeView * TreeView::create(GList * list)
 TreeView::TreeView() :
     _list(nullptr),
     _rootNode(nullptr),
-    _indent(30)
+    _indent(30),
+    _virtual(false),
+    _rowsChanged(false)
 {
 }
 
 TreeView::~TreeView()
 {
+    if (_virtual)
+    {
+        _list->unSchedule(COMMIT_ROWS_KEY);
+        _list->itemRenderer = nullptr;
+        for (auto &it : _boundNodes)
+        {
+            it->_cell->setData(nullptr);
+            it->setCell(nullptr);
+        }
+    }
     CC_SAFE_RELEASE(_rootNode);
     CC_SAFE_RELEASE(_list);
 }
@@ -55,19 +69,30 @@ bool TreeView::init(GList * list)
 
 TreeNode * TreeView::getSelectedNode() const
 {
-    if (_list->getSelectedIndex() != -1)
-        return (TreeNode*)_list->getChildAt(_list->getSelectedIndex())->getData();
-    else
+    ((TreeView*)this)->checkRows();
+
+    int index = _list->getSelectedIndex();
+    if (index == -1)
         return nullptr;
+    else if (_virtual)
+        return _rows[index];
+    else
+        return (TreeNode*)_list->getChildAt(index)->getData();
 }
 
 void TreeView::getSelection(std::vector<TreeNode*>& result) const
 {
+    ((TreeView*)this)->checkRows();
+
     std::vector<int> ids;
     _list->getSelection(ids);
     for (auto &it : ids)
     {
-        TreeNode* node = (TreeNode*)_list->getChildAt(it)->getData();
+        TreeNode* node;
+        if (_virtual)
+            node = _rows[it];
+        else
+            node = (TreeNode*)_list->getChildAt(it)->getData();
         result.push_back(node);
     }
 }
@@ -80,13 +105,24 @@ void TreeView::addSelection(TreeNode * node, bool scrollItToView)
         parentNode->setExpaned(true);
         parentNode = parentNode->_parent;
     }
-    if (node->_cell != nullptr)
+    if (_virtual)
+    {
+        checkRows();
+        _list->addSelection(getRowIndex(node), scrollItToView);
+    }
+    else if (node->_cell != nullptr)
         _list->addSelection(_list->getChildIndex(node->_cell), scrollItToView);
 }
 
 void TreeView::removeSelection(TreeNode * node)
 {
-    if (node->_cell != nullptr)
+    if (_virtual)
+    {
+        checkRows();
+        if (isChildrenShown(node->_parent))
+            _list->removeSelection(getRowIndex(node));
+    }
+    else if (node->_cell != nullptr)
         _list->removeSelection(_list->getChildIndex(node->_cell));
 }
 
@@ -95,8 +131,21 @@ void TreeView::clearSelection()
     _list->clearSelection();
 }
 
+int TreeView::getNumRows() const
+{
+    return (int)_rows.size();
+}
+
+TreeNode * TreeView::getNodeAt(int rowIndex) const
+{
+    return _rows[rowIndex];
+}
+
 int TreeView::getNodeIndex(TreeNode * node) const
 {
+    if (_virtual)
+        return isChildrenShown(node->_parent) ? getRowIndex(node) : -1;
+
     if (node->_cell == nullptr)
         return -1;
     else
@@ -143,6 +192,11 @@ void TreeView::createCell(TreeNode * node)
     CCASSERT(obj, "Unable to create tree cell");
     node->setCell(obj);
 
+    setupCell(node);
+}
+
+void TreeView::setupCell(TreeNode * node)
+{
     GObject* indentObj = node->_cell->getChild("indent");
     if (indentObj != nullptr)
         indentObj->setWidth((node->_level - 1) * _indent);
@@ -153,7 +207,7 @@ void TreeView::createCell(TreeNode * node)
         if (node->isFolder())
         {
             expandButton->setVisible(true);
-            expandButton->addClickListener(CALLBACK_1(TreeView::onClickExpandButton, this));
+            expandButton->addClickListener(CALLBACK_1(TreeView::onClickExpandButton, this), EventTag(this));
             expandButton->setData(node);
             expandButton->setSelected(node->isExpanded());
         }
@@ -204,11 +258,23 @@ int TreeView::getInsertIndexForNode(TreeNode * node)
 
 void TreeView::afterRemoved(TreeNode * node)
 {
-    removeNode(node);
+    if (_virtual)
+        unbindRemovedCells();
+    else
+        removeNode(node);
 }
 
 void TreeView::afterExpanded(TreeNode * node)
 {
+    if (_virtual)
+    {
+        refreshFolderRows(node);
+        if (node != _rootNode && treeNodeWillExpand != nullptr)
+            treeNodeWillExpand(node, true);
+        return;
+    }
+
+    node->updateVisibleCount();
     if (node != _rootNode && treeNodeWillExpand != nullptr)
         treeNodeWillExpand(node, true);
 
@@ -233,6 +299,15 @@ void TreeView::afterExpanded(TreeNode * node)
 
 void TreeView::afterCollapsed(TreeNode * node)
 {
+    if (_virtual)
+    {
+        if (node != _rootNode && treeNodeWillExpand != nullptr)
+            treeNodeWillExpand(node, false);
+        refreshFolderRows(node);
+        return;
+    }
+
+    node->updateVisibleCount();
     if (node != _rootNode && treeNodeWillExpand != nullptr)
         treeNodeWillExpand(node, false);
 
@@ -343,8 +418,12 @@ void TreeView::onClickExpandButton(EventContext * context)
             node->setExpaned(true);
         else
             node->setExpaned(false);
+        checkRows();
         _list->getScrollPane()->setPosY(posY);
-        _list->getScrollPane()->scrollToView(node->_cell);
+        if (_virtual)
+            _list->scrollToView(getRowIndex(node));
+        else
+            _list->getScrollPane()->scrollToView(node->_cell);
     }
     else
     {
@@ -368,9 +447,195 @@ void TreeView::onClickItem(EventContext * context)
 
     if (_list->getScrollPane() != nullptr)
     {
+        checkRows();
         _list->getScrollPane()->setPosY(posY);
-        _list->getScrollPane()->scrollToView(node->_cell);
+        if (_virtual)
+        {
+            if (isChildrenShown(node->_parent))
+                _list->scrollToView(getRowIndex(node));
+        }
+        else
+            _list->getScrollPane()->scrollToView(node->_cell);
+    }
+}
+
+void TreeView::setVirtual()
+{
+    if (_virtual)
+        return;
+
+    std::vector<TreeNode*> selection;
+    getSelection(selection);
+    hideFolderNode(_rootNode);
+
+    _virtual = true;
+    _list->itemRenderer = CALLBACK_2(TreeView::renderRow, this);
+    _list->setVirtual();
+
+    for (auto &it : selection)
+        _pendingSelection.pushBack(it);
+    _rows.clear();
+    collectRows(_rootNode, _rows);
+    _rowsChanged = true;
+    commitRows(0);
+}
+
+bool TreeView::isChildrenShown(TreeNode * folderNode) const
+{
+    for (TreeNode* node = folderNode; node != _rootNode; node = node->_parent)
+    {
+        if (node == nullptr || !node->_expanded)
+            return false;
     }
+    return true;
+}
+
+int TreeView::getRowIndex(TreeNode * node) const
+{
+    //a row comes right after the row of its parent and the rows of the siblings before it
+    int index = -1;
+    for (TreeNode* it = node; it != _rootNode; it = it->_parent)
+    {
+        TreeNode* parent = it->_parent;
+        if (parent == nullptr || !parent->_expanded)
+            return -1;
+        index += 1 + parent->getChildRowOffset(it);
+    }
+    return index;
+}
+
+void TreeView::collectRows(TreeNode * folderNode, std::vector<TreeNode*>& result) const
+{
+    //depth first with an explicit stack, a deep tree must not run out of call stack
+    std::vector<std::pair<TreeNode*, int>> stack;
+    stack.push_back(std::make_pair(folderNode, 0));
+    while (!stack.empty())
+    {
+        TreeNode* parent = stack.back().first;
+        int index = stack.back().second;
+        if (index >= (int)parent->_children.size())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        stack.back().second++;
+        TreeNode* node = parent->_children.at(index);
+        result.push_back(node);
+        if (node->_isFolder && node->_expanded && !node->_children.empty())
+            stack.push_back(std::make_pair(node, 0));
+    }
+}
+
+void TreeView::refreshFolderRows(TreeNode * folderNode)
+{
+    int oldCount = folderNode->_visibleCount;
+    folderNode->updateVisibleCount();
+    if (folderNode != _rootNode && !isChildrenShown(folderNode->_parent))
+        return;
+
+    //only the rows below the folder change
+    int index = getRowIndex(folderNode) + 1;
+    removeRows(index, oldCount);
+    std::vector<TreeNode*> rows;
+    collectRows(folderNode, rows);
+    _rows.insert(_rows.begin() + index, rows.begin(), rows.end());
+}
+
+void TreeView::insertRows(TreeNode * node)
+{
+    setRowsChanged();
+    std::vector<TreeNode*> rows;
+    rows.push_back(node);
+    if (node->_isFolder && node->_expanded)
+        collectRows(node, rows);
+    int index = getRowIndex(node);
+    _rows.insert(_rows.begin() + index, rows.begin(), rows.end());
+}
+
+void TreeView::removeRows(int index, int count)
+{
+    setRowsChanged();
+    _rows.erase(_rows.begin() + index, _rows.begin() + index + count);
+}
+
+void TreeView::setRowsChanged()
+{
+    if (_rowsChanged)
+        return;
+
+    //The list is told once per frame, its selection is mapped back through the nodes then.
+    //Called before _rows is first spliced, while it still matches the list.
+    _rowsChanged = true;
+    std::vector<int> ids;
+    _list->getSelection(ids);
+    for (auto &it : ids)
+        _pendingSelection.pushBack(_rows[it]);
+    _list->scheduleOnce(CALLBACK_1(TreeView::commitRows, this), 0, COMMIT_ROWS_KEY);
+}
+
+void TreeView::checkRows()
+{
+    if (_rowsChanged)
+    {
+        _list->unSchedule(COMMIT_ROWS_KEY);
+        commitRows(0);
+    }
+}
+
+void TreeView::commitRows(float dt)
+{
+    _rowsChanged = false;
+    _list->clearSelection();
+    _list->setNumItems((int)_rows.size());
+
+    for (auto &it : _pendingSelection)
+    {
+        if (it->_root == this && isChildrenShown(it->_parent))
+            _list->addSelection(getRowIndex(it), false);
+    }
+    _pendingSelection.clear();
+}
+
+void TreeView::unbindRemovedCells()
+{
+    for (auto it = _boundNodes.begin(); it != _boundNodes.end(); )
+    {
+        TreeNode* node = *it;
+        if (node->_root != this)
+        {
+            node->_cell->setData(nullptr);
+            node->setCell(nullptr);
+            it = _boundNodes.erase(it);
+        }
+        else
+            it++;
+    }
+}
+
+void TreeView::renderRow(int index, GObject * obj)
+{
+    if (index >= (int)_rows.size())
+        return;
+
+    TreeNode* node = _rows[index];
+    GComponent* cell = obj->as<GComponent>();
+    TreeNode* oldNode = (TreeNode*)cell->getData();
+    if (oldNode != node)
+    {
+        //cells are recycled by the list, a node only keeps the one it was rendered into last
+        if (oldNode != nullptr)
+        {
+            oldNode->setCell(nullptr);
+            _boundNodes.erase(oldNode);
+        }
+        if (node->_cell != nullptr)
+            node->_cell->setData(nullptr);
+        node->setCell(cell);
+        _boundNodes.insert(node);
+    }
+
+    setupCell(node);
 }
 
 NS_FGUI_END
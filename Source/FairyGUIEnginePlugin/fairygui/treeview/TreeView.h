@@ -3,11 +3,14 @@
 
 #include "FGUIMacros.h"
 
+#include <unordered_set>
+
 #include "event/EventDispatcher.h"
 #include "TreeNode.h"
 
 NS_FGUI_BEGIN
 
+class GObject;
 class GList;
 class GComponent;
 
@@ -32,6 +35,13 @@ public:
     void expandAll(TreeNode* folderNode);
     void collapseAll(TreeNode* folderNode);
 
+    //Runs the list virtual. The visible nodes are kept as a flat row array and only the rows
+    //on screen get cells, taken from the list's default item; treeNodeCreateCell is not used.
+    void setVirtual();
+    bool isVirtual() const { return _virtual; }
+    int getNumRows() const;
+    TreeNode* getNodeAt(int rowIndex) const;
+
     TreeNodeCreateCellFunction treeNodeCreateCell;
     TreeNodeRenderFunction treeNodeRender;
     TreeNodeWillExpandFunction treeNodeWillExpand;
@@ -43,6 +53,7 @@ protected:
 private:
     bool init(GList* list);
     void createCell(TreeNode* node);
+    void setupCell(TreeNode* node);
     void afterInserted(TreeNode* node);
     int getInsertIndexForNode(TreeNode* node);
     void afterRemoved(TreeNode* node);
@@ -53,12 +64,29 @@ private:
     void hideFolderNode(TreeNode* folderNode);
     void removeNode(TreeNode* node);
 
+    bool isChildrenShown(TreeNode* folderNode) const;
+    int getRowIndex(TreeNode* node) const;
+    void collectRows(TreeNode* folderNode, std::vector<TreeNode*>& result) const;
+    void refreshFolderRows(TreeNode* folderNode);
+    void insertRows(TreeNode* node);
+    void removeRows(int index, int count);
+    void setRowsChanged();
+    void checkRows();
+    void commitRows(float dt);
+    void unbindRemovedCells();
+    void renderRow(int index, GObject* obj);
+
     void onClickItem(EventContext* context);
     void onClickExpandButton(EventContext* context);
 
     GList* _list;
     int _indent;
     TreeNode* _rootNode;
+    bool _virtual;
+    bool _rowsChanged;
+    std::vector<TreeNode*> _rows;
+    Vector<TreeNode*> _pendingSelection;
+    std::unordered_set<TreeNode*> _boundNodes;
 
     friend class TreeNode;
 };
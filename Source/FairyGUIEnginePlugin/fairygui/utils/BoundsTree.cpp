@@ -0,0 +1,74 @@
+#include "BoundsTree.h"
+
+NS_FGUI_BEGIN
+
+static const VRectanglef EMPTY_BOUNDS(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+BoundsTree::BoundsTree() :
+    _count(0),
+    _capacity(0)
+{
+}
+
+void BoundsTree::reset(int count)
+{
+    _count = count;
+
+    int cap = 1;
+    while (cap < count)
+        cap <<= 1;
+
+    if (cap != _capacity)
+    {
+        _capacity = cap;
+        _nodes.resize(_capacity * 2);
+    }
+
+    for (int i = _capacity; i < _capacity * 2; i++)
+        _nodes[i] = EMPTY_BOUNDS;
+}
+
+void BoundsTree::setRect(int index, float x, float y, float width, float height)
+{
+    VRectanglef& leaf = _nodes[_capacity + index];
+    leaf.m_vMin.x = x;
+    leaf.m_vMin.y = y;
+    leaf.m_vMax.x = x + width;
+    leaf.m_vMax.y = y + height;
+}
+
+void BoundsTree::updateRect(int index, float x, float y, float width, float height)
+{
+    setRect(index, x, y, width, height);
+
+    for (int node = (_capacity + index) >> 1; node >= 1; node >>= 1)
+        combine(node);
+}
+
+void BoundsTree::build()
+{
+    for (int node = _capacity - 1; node >= 1; node--)
+        combine(node);
+}
+
+const VRectanglef& BoundsTree::getBounds() const
+{
+    if (_capacity == 0)
+        return EMPTY_BOUNDS;
+    else
+        return _nodes[1]; //with a single leaf, the leaf is the root
+}
+
+void BoundsTree::combine(int node)
+{
+    const VRectanglef& left = _nodes[node << 1];
+    const VRectanglef& right = _nodes[(node << 1) + 1];
+    VRectanglef& parent = _nodes[node];
+
+    parent.m_vMin.x = left.m_vMin.x < right.m_vMin.x ? left.m_vMin.x : right.m_vMin.x;
+    parent.m_vMin.y = left.m_vMin.y < right.m_vMin.y ? left.m_vMin.y : right.m_vMin.y;
+    parent.m_vMax.x = left.m_vMax.x > right.m_vMax.x ? left.m_vMax.x : right.m_vMax.x;
+    parent.m_vMax.y = left.m_vMax.y > right.m_vMax.y ? left.m_vMax.y : right.m_vMax.y;
+}
+
+NS_FGUI_END
@@ -0,0 +1,34 @@
+#ifndef __BOUNDSTREE_H__
+#define __BOUNDSTREE_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+//A segment tree over child rectangles. Changing one rectangle costs O(log n),
+//the union of all rectangles is always available at the root.
+class BoundsTree
+{
+public:
+    BoundsTree();
+
+    void reset(int count);
+    void setRect(int index, float x, float y, float width, float height);
+    void updateRect(int index, float x, float y, float width, float height);
+    void build();
+
+    int getCount() const { return _count; }
+    bool isEmpty() const { return _count == 0; }
+    const VRectanglef& getBounds() const;
+
+private:
+    void combine(int node);
+
+    std::vector<VRectanglef> _nodes;
+    int _count;
+    int _capacity;
+};
+
+NS_FGUI_END
+
+#endif
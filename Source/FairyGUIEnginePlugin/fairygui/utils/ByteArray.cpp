@@ -1,10 +1,54 @@
 #include "ByteArray.h"
 
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
+static inline unsigned short swapBytes(unsigned short n)
+{
+#ifdef _MSC_VER
+    return _byteswap_ushort(n);
+#else
+    return __builtin_bswap16(n);
+#endif
+}
+
+static inline unsigned int swapBytes(unsigned int n)
+{
+#ifdef _MSC_VER
+    return _byteswap_ulong(n);
+#else
+    return __builtin_bswap32(n);
+#endif
+}
+
+static inline unsigned long long swapBytes(unsigned long long n)
+{
+#ifdef _MSC_VER
+    return _byteswap_uint64(n);
+#else
+    return __builtin_bswap64(n);
+#endif
+}
+
+//maps a value type to the unsigned type of the same size, which swapBytes takes
+template<size_t N> struct SwapType {};
+template<> struct SwapType<1> { typedef unsigned char Type; };
+template<> struct SwapType<2> { typedef unsigned short Type; };
+template<> struct SwapType<4> { typedef unsigned int Type; };
+template<> struct SwapType<8> { typedef unsigned long long Type; };
+
+static inline unsigned char swapBytes(unsigned char n)
+{
+    return n;
+}
+
 ByteArray::ByteArray() :
     _buffer(nullptr),
     _pos(0),
     _length(0),
     _endian(ENDIAN_LITTLE),
+    _swap(checkCPUEndian() != ENDIAN_LITTLE),
     _flag(-1)
 {
 };
@@ -57,13 +101,52 @@ ByteArray* ByteArray::createWithBuffer(char* buffer, size_t len, bool transferOw
     return ba;
 }
 
+ByteArray* ByteArray::createView(const char* buffer, size_t len)
+{
+    //never written or freed through a view
+    return createWithBuffer(const_cast<char*>(buffer), len, false);
+}
+
+template<typename T> T ByteArray::readValue()
+{
+    typedef typename SwapType<sizeof(T)>::Type U;
+
+    U n;
+    memcpy(&n, this->_buffer + this->_pos, sizeof(n));
+    this->_pos += sizeof(n);
+
+    //the byte order is decided once in setEndian, no per byte loop here
+    if (this->_swap)
+        n = swapBytes(n);
+
+    T ret;
+    memcpy(&ret, &n, sizeof(ret));
+    return ret;
+}
+
+bool ByteArray::readBytes(char* dest, size_t len)
+{
+    if (getBytesAvailable() < len)
+        return false;
+
+    memcpy(dest, this->_buffer + this->_pos, len);
+    this->_pos += len;
+    return true;
+}
+
+ByteSpan ByteArray::readSpan(size_t len)
+{
+    if (getBytesAvailable() < len)
+        len = getBytesAvailable();
+
+    ByteSpan span(this->_buffer + this->_pos, len);
+    this->_pos += len;
+    return span;
+}
+
 bool ByteArray::readBool()
 {
-    bool b;
-    char* p = (char*)&b;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(b));
-    this->_pos += sizeof(b);
-    return b;
+    return readValue<unsigned char>() != 0;
 }
 
 
@@ -77,11 +160,7 @@ void ByteArray::writeBool(bool value)
 
 short ByteArray::readShort()
 {
-    short n = 0;
-    char* p = (char*)&n;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(n));
-    this->_pos += 2;
-    return n;
+    return readValue<short>();
 }
 
 
@@ -94,11 +173,7 @@ void ByteArray::writeShort(short value)
 
 
 int ByteArray::readInt() {
-    int n;
-    char* p = (char*)&n;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(n));
-    this->_pos += 4;
-    return n;
+    return readValue<int>();
 }
 
 
@@ -111,12 +186,7 @@ void ByteArray::writeInt(int value)
 
 
 unsigned int ByteArray::readUnsignedInt() {
-    unsigned int n;
-    char* p = (char*)&n;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(n));
-
-    this->_pos += 4;
-    return n;
+    return readValue<unsigned int>();
 }
 
 
@@ -129,11 +199,7 @@ void ByteArray::writeUnsignedInt(unsigned int value)
 
 
 unsigned short ByteArray::readUnsignedShort() {
-    unsigned short n;
-    char* p = (char*)&n;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(n));
-    this->_pos += 2;
-    return n;
+    return readValue<unsigned short>();
 }
 
 
@@ -180,11 +246,7 @@ void ByteArray::writeUnsignedChar(unsigned char value)
 
 long long ByteArray::readLongLong()
 {
-    long long n;
-    char* p = (char*)&n;
-    copyMemory(p, this->_buffer + this->_pos, sizeof(n));
-    this->_pos += sizeof(n);
-    return n;
+    return readValue<long long>();
 }
 
 
@@ -203,17 +265,11 @@ std::string ByteArray::readString()
 
 std::string ByteArray::readString(size_t len)
 {
-    char* value = new char[len + 1];
-
-    value[len] = '\0';
-    memcpy(value, this->_buffer + this->_pos, len);
+    //like the C string it used to be copied through, the text ends at the first zero byte
+    const char* p = this->_buffer + this->_pos;
     this->_pos += len;
 
-    std::string str(value);
-    delete[] value;
-    value = nullptr;
-
-    return str;
+    return std::string(p, strnlen(p, len));
 }
 
 void ByteArray::writeString(const std::string& value)
@@ -225,24 +281,6 @@ void ByteArray::writeString(const std::string& value)
     this->_pos += len;
 }
 
-void ByteArray::copyMemory(void* to, const void* from, size_t len)
-{
-    char* t = (char*)to;
-    char* f = (char*)from;
-    if (_endian == ENDIAN_LITTLE)
-    {
-        memcpy(t, f, len);
-    }
-    else if (_endian == ENDIAN_BIG)
-    {
-        for (int i = len - 1; i >= 0; i--)
-        {
-            t[(len - 1) - i] = f[i];
-        }
-    }
-}
-
-
 const char* ByteArray::getBuffer()
 {
     return this->_buffer;
@@ -270,6 +308,7 @@ int ByteArray::checkCPUEndian() {
 void ByteArray::setEndian(int n)
 {
     this->_endian = n;
+    this->_swap = n != checkCPUEndian();
 }
 
 
@@ -12,11 +12,23 @@
 #include <string>
 #include "FGUIMacros.h"
 
+//A range of bytes in a buffer owned by someone else.
+struct ByteSpan
+{
+    const char* data;
+    size_t length;
+
+    ByteSpan() : data(nullptr), length(0) {}
+    ByteSpan(const char* data, size_t length) : data(data), length(length) {}
+};
+
 class FGUI_IMPEXP ByteArray
 {
 public:
     static ByteArray* create(size_t len);
     static ByteArray* createWithBuffer(char* buffer, size_t len, bool transferOwnerShip = false);
+    //read only view, the buffer must outlive the ByteArray
+    static ByteArray* createView(const char* buffer, size_t len);
 
     static int checkCPUEndian();
 
@@ -51,6 +63,11 @@ public:
     unsigned char readUnsignedByte();
     void writeUnsignedChar(unsigned char value);
 
+    //copies len bytes to dest, returns false without reading if fewer are available
+    bool readBytes(char* dest, size_t len);
+    //returns the next len bytes without copying them, valid as long as the buffer is
+    ByteSpan readSpan(size_t len);
+
     const char* getBuffer();
     void clear();
 
@@ -68,12 +85,13 @@ protected:
     ByteArray();
 
 private:
-    void copyMemory(void* to, const void* from, size_t len);
+    template<typename T> T readValue();
 
     char* _buffer;
     int _pos;
     size_t _length;
     int _endian;
+    bool _swap;
     short _flag;
 };
 
@@ -0,0 +1,140 @@
+#include "MappedFile.h"
+#include "UIConfig.h"
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+NS_FGUI_BEGIN
+
+MappedFile::MappedFile() :
+    _data(nullptr),
+    _size(0),
+    _mapped(false)
+#ifdef WIN32
+    , _file(INVALID_HANDLE_VALUE),
+    _mapping(NULL)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string & path)
+{
+    close();
+
+    if (UIConfig::memoryMappedPackages)
+    {
+        VFileAccessManager::NativePathResult result;
+        if (VFileAccessManager::GetInstance()->MakePathNative(path.c_str(), result, VFileSystemAccessMode::READ, VFileSystemElementType::FILE) == HKV_SUCCESS
+            && map(result.m_sNativePath.AsChar()))
+            return true;
+    }
+
+    return read(path);
+}
+
+void MappedFile::close()
+{
+    if (_mapped)
+    {
+#ifdef WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+        _mapping = NULL;
+        _file = INVALID_HANDLE_VALUE;
+#else
+        munmap((void*)_data, _size);
+#endif
+        _mapped = false;
+    }
+    else
+        std::vector<char>().swap(_buffer);
+
+    _data = nullptr;
+    _size = 0;
+}
+
+bool MappedFile::map(const std::string & nativePath)
+{
+#ifdef WIN32
+    HANDLE file = CreateFileA(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    _file = file;
+    _mapping = mapping;
+    _data = (const char*)data;
+    _size = (size_t)size.QuadPart;
+#else
+    int fd = ::open(nativePath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    //the mapping keeps its own reference to the file
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    _data = (const char*)data;
+    _size = (size_t)st.st_size;
+#endif
+
+    _mapped = true;
+    return true;
+}
+
+bool MappedFile::read(const std::string & path)
+{
+    IVFileInStream* stream = VFileAccessManager::GetInstance()->Open(path.c_str());
+    if (stream == nullptr)
+        return false;
+
+    _buffer.resize(stream->GetSize());
+    stream->Read(_buffer.data(), _buffer.size());
+    stream->Close();
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return true;
+}
+
+NS_FGUI_END
@@ -0,0 +1,45 @@
+#ifndef __MAPPEDFILE_H__
+#define __MAPPEDFILE_H__
+
+#include "FGUIMacros.h"
+#include "ByteArray.h"
+
+NS_FGUI_BEGIN
+
+//Read only contents of a whole file. When the file resolves to a native path it is
+//memory mapped: pages are only read when touched and are shared with other processes
+//mapping the same file. Otherwise (files inside archives, UIConfig::memoryMappedPackages
+//off, mapping failed) it is read through VFileAccessManager into a heap buffer.
+class FGUI_IMPEXP MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    const char* getData() const { return _data; }
+    size_t getSize() const { return _size; }
+    ByteSpan getSpan() const { return ByteSpan(_data, _size); }
+    bool isMapped() const { return _mapped; }
+
+private:
+    bool map(const std::string& nativePath);
+    bool read(const std::string& path);
+
+    const char* _data;
+    size_t _size;
+    bool _mapped;
+    std::vector<char> _buffer;
+#ifdef WIN32
+    HANDLE _file;
+    HANDLE _mapping;
+#endif
+
+    CC_DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
+NS_FGUI_END
+
+#endif
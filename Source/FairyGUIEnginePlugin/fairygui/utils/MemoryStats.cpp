@@ -0,0 +1,133 @@
+#include "MemoryStats.h"
+
+#include <sstream>
+
+NS_FGUI_BEGIN
+
+using namespace tinyxml2;
+
+static const char* CATEGORY_NAMES[] = { "xmlDom", "textures", "vertexBuffers", "textLayout",
+    "gearsRelations", "controllersTransitions", "eventListeners", "fonts", "hitTest", "objects", "other" };
+
+MemoryStats::MemoryStats()
+{
+    clear();
+}
+
+void MemoryStats::addTexture(const std::string & name, size_t bytes)
+{
+    _textures[name] += bytes;
+    _bytes[TEXTURES] += bytes;
+}
+
+size_t MemoryStats::getTotal() const
+{
+    size_t total = 0;
+    for (int i = 0; i < CATEGORY_COUNT; i++)
+        total += _bytes[i];
+    return total;
+}
+
+void MemoryStats::merge(const MemoryStats & other)
+{
+    for (int i = 0; i < CATEGORY_COUNT; i++)
+        _bytes[i] += other._bytes[i];
+    for (auto &it : other._textures)
+        _textures[it.first] += it.second;
+    _objectCount += other._objectCount;
+}
+
+void MemoryStats::clear()
+{
+    for (int i = 0; i < CATEGORY_COUNT; i++)
+        _bytes[i] = 0;
+    _textures.clear();
+    _objectCount = 0;
+}
+
+std::string MemoryStats::toJson() const
+{
+    //keys are written in a fixed order so two dumps can be diffed line by line
+    std::ostringstream ss;
+    ss << "{\n  \"total\": " << getTotal() << ",\n  \"objects\": " << _objectCount << ",\n  \"categories\": {";
+    for (int i = 0; i < CATEGORY_COUNT; i++)
+    {
+        if (i != 0)
+            ss << ",";
+        ss << "\n    \"" << CATEGORY_NAMES[i] << "\": " << _bytes[i];
+    }
+    ss << "\n  },\n  \"textures\": {";
+    bool first = true;
+    for (auto &it : _textures)
+    {
+        if (!first)
+            ss << ",";
+        first = false;
+        ss << "\n    \"" << it.first << "\": " << it.second;
+    }
+    ss << "\n  }\n}\n";
+
+    return ss.str();
+}
+
+bool MemoryStats::save(const std::string & filePath) const
+{
+    IVFileOutStream* stream = VFileAccessManager::GetInstance()->Create(filePath.c_str());
+    if (stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot write memory stats to '%s'", filePath.c_str());
+        return false;
+    }
+
+    std::string json = toJson();
+    stream->Write(json.c_str(), json.size());
+    stream->Close();
+    return true;
+}
+
+const char * MemoryStats::getCategoryName(Category category)
+{
+    return CATEGORY_NAMES[category];
+}
+
+size_t MemoryStats::stringBytes(const std::string & str)
+{
+    //short strings live inside the std::string itself
+    if (str.capacity() < sizeof(std::string))
+        return 0;
+    else
+        return str.capacity() + 1;
+}
+
+static size_t xmlNodeBytes(const XMLNode* node)
+{
+    size_t bytes = 0;
+    for (const XMLNode* child = node->FirstChild(); child; child = child->NextSibling())
+    {
+        //names and values are parsed in place, so their lengths add up to the character buffer
+        const XMLElement* ele = child->ToElement();
+        if (ele)
+        {
+            bytes += sizeof(XMLElement) + strlen(ele->Name()) + 1;
+            for (const XMLAttribute* attr = ele->FirstAttribute(); attr; attr = attr->Next())
+                bytes += sizeof(XMLAttribute) + strlen(attr->Name()) + strlen(attr->Value()) + 2;
+        }
+        else if (child->ToText())
+            bytes += sizeof(XMLText) + strlen(child->Value()) + 1;
+        else
+            bytes += sizeof(XMLComment) + strlen(child->Value()) + 1;
+
+        bytes += xmlNodeBytes(child);
+    }
+    return bytes;
+}
+
+size_t MemoryStats::xmlBytes(const TXMLDocument * doc)
+{
+    if (doc == nullptr)
+        return 0;
+
+    return sizeof(XMLDocument) + xmlNodeBytes(doc);
+}
+
+NS_FGUI_END
@@ -0,0 +1,83 @@
+#ifndef __MEMORYSTATS_H__
+#define __MEMORYSTATS_H__
+
+#include "FGUIMacros.h"
+
+NS_FGUI_BEGIN
+
+//Approximate heap usage, grouped by category. Filled by UIPackage::collectMemoryStats
+//and GObject::collectMemoryStats; the numbers are estimates from container sizes,
+//good for spotting growth and for diffing two builds, not for exact accounting.
+class FGUI_IMPEXP MemoryStats
+{
+public:
+    enum Category
+    {
+        XML_DOM,
+        TEXTURES,
+        VERTEX_BUFFERS,
+        TEXT_LAYOUT,
+        GEARS_RELATIONS,
+        CONTROLLERS_TRANSITIONS,
+        EVENT_LISTENERS,
+        FONTS,
+        HIT_TEST,
+        OBJECTS,
+        OTHER,
+        CATEGORY_COUNT
+    };
+
+    MemoryStats();
+
+    void add(Category category, size_t bytes) { _bytes[category] += bytes; }
+    void addTexture(const std::string& name, size_t bytes);
+    void addObject() { _objectCount++; }
+
+    size_t get(Category category) const { return _bytes[category]; }
+    size_t getTotal() const;
+    int getObjectCount() const { return _objectCount; }
+    const std::map<std::string, size_t>& getTextures() const { return _textures; }
+
+    void merge(const MemoryStats& other);
+    void clear();
+
+    std::string toJson() const;
+    bool save(const std::string& filePath) const;
+
+    static const char* getCategoryName(Category category);
+
+    static size_t stringBytes(const std::string& str);
+    static size_t xmlBytes(const TXMLDocument* doc);
+
+    template<typename K, typename V>
+    static size_t mapBytes(const std::unordered_map<K, V>& map);
+    template<typename V>
+    static size_t mapBytes(const std::unordered_map<std::string, V>& map);
+
+private:
+    size_t _bytes[CATEGORY_COUNT];
+    std::map<std::string, size_t> _textures;
+    int _objectCount;
+};
+
+template<typename K, typename V>
+inline size_t MemoryStats::mapBytes(const std::unordered_map<K, V>& map)
+{
+    //one node per element (value + next pointer + cached hash) and one pointer per bucket
+    return map.size() * (sizeof(std::pair<const K, V>) + sizeof(void*) * 2)
+        + map.bucket_count() * sizeof(void*);
+}
+
+template<typename V>
+inline size_t MemoryStats::mapBytes(const std::unordered_map<std::string, V>& map)
+{
+    size_t bytes = map.size() * (sizeof(std::pair<const std::string, V>) + sizeof(void*) * 2)
+        + map.bucket_count() * sizeof(void*);
+    for (auto &it : map)
+        bytes += stringBytes(it.first);
+    return bytes;
+}
+
+NS_FGUI_END
+
+#endif
@@ -0,0 +1,229 @@
+#include "Profiler.h"
+
+#include <sstream>
+#include <chrono>
+
+NS_FGUI_BEGIN
+
+static const int DEFAULT_FRAME_CAPACITY = 300;
+
+static const char* COUNTER_NAMES[] = { "drawCalls", "vertices", "eventsDispatched", "objectsCreated", "timersFired", "listBudgetOverruns", "nodesCulled", "hitTests", "hitTestsSkipped", "atlasDrawsSaved" };
+
+Profiler Profiler::_inst;
+
+Profiler::Profiler() :
+    _current(0),
+    _depth(0),
+    _frameId(0),
+    _enabled(false)
+{
+    _frames.resize(DEFAULT_FRAME_CAPACITY);
+    for (auto &it : _frames)
+        resetFrame(it);
+    resetCounts();
+}
+
+void Profiler::setEnabled(bool value)
+{
+    if (_enabled != value)
+    {
+        //other threads only read the owner after they have seen the profiler enabled
+        if (value)
+            _ownerThread = std::this_thread::get_id();
+        _enabled = value;
+        _depth = 0;
+        resetCounts();
+        resetFrame(_frames[_current]);
+        _frames[_current].frameId = _frameId;
+        _frames[_current].start = now();
+    }
+}
+
+void Profiler::setFrameCapacity(int value)
+{
+    if (value < 1)
+        value = 1;
+
+    _frames.resize(value);
+    for (auto &it : _frames)
+        resetFrame(it);
+    resetCounts();
+    _current = 0;
+    _depth = 0;
+}
+
+void Profiler::beginFrame()
+{
+    _frameId++;
+    if (!_enabled)
+        return;
+
+    long long time = now();
+    _frames[_current].end = time;
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        _frames[_current].counters[i] = _counts[i].exchange(0, std::memory_order_relaxed);
+
+    _current = (_current + 1) % _frames.size();
+    Frame& frame = _frames[_current];
+    resetFrame(frame);
+    frame.frameId = _frameId;
+    frame.start = time;
+    _depth = 0;
+}
+
+int Profiler::beginZone(const char * name)
+{
+    if (!_enabled || std::this_thread::get_id() != _ownerThread)
+        return -1;
+
+    Frame& frame = _frames[_current];
+    Zone zone;
+    zone.name = name;
+    zone.start = now();
+    zone.end = 0;
+    zone.depth = _depth++;
+    frame.zones.push_back(zone);
+    return (int)frame.zones.size() - 1;
+}
+
+void Profiler::endZone(int index)
+{
+    if (index < 0 || !_enabled)
+        return;
+
+    //a zone that spans a frame boundary is dropped
+    std::vector<Zone>& zones = _frames[_current].zones;
+    if (index < (int)zones.size() && zones[index].end == 0)
+    {
+        zones[index].end = now();
+        _depth--;
+    }
+}
+
+int Profiler::getCount(Counter counter) const
+{
+    int last = (_current + _frames.size() - 1) % _frames.size();
+    return _frames[last].counters[counter];
+}
+
+float Profiler::getFrameTime() const
+{
+    int last = (_current + _frames.size() - 1) % _frames.size();
+    const Frame& frame = _frames[last];
+    if (frame.frameId < 0)
+        return 0;
+    else
+        return (float)(toMicroseconds(frame.end - frame.start) / 1000.0);
+}
+
+std::string Profiler::exportTrace() const
+{
+    std::ostringstream ss;
+    ss.setf(std::ios::fixed);
+    ss.precision(3);
+
+    ss << "{\"traceEvents\":[";
+    bool first = true;
+    int cnt = (int)_frames.size();
+    for (int i = 1; i <= cnt; i++)
+    {
+        const Frame& frame = _frames[(_current + i) % cnt];
+        if (frame.frameId < 0 || frame.end == 0)
+            continue;
+
+        if (!first)
+            ss << ",";
+        first = false;
+
+        ss << "{\"name\":\"frame " << frame.frameId << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << toMicroseconds(frame.start)
+            << ",\"dur\":" << toMicroseconds(frame.end - frame.start) << "}";
+
+        for (auto &it : frame.zones)
+        {
+            if (it.end == 0)
+                continue;
+
+            ss << ",{\"name\":\"" << it.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+                << ",\"ts\":" << toMicroseconds(it.start)
+                << ",\"dur\":" << toMicroseconds(it.end - it.start) << "}";
+        }
+
+        ss << ",{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << toMicroseconds(frame.start) << ",\"args\":{";
+        for (int j = 0; j < COUNTER_COUNT; j++)
+        {
+            if (j != 0)
+                ss << ",";
+            ss << "\"" << COUNTER_NAMES[j] << "\":" << frame.counters[j];
+        }
+        ss << "}}";
+    }
+    ss << "]}";
+
+    return ss.str();
+}
+
+bool Profiler::saveTrace(const std::string & filePath) const
+{
+    IVFileOutStream* stream = VFileAccessManager::GetInstance()->Create(filePath.c_str());
+    if (stream == nullptr)
+    {
+        CCLOGWARN("FairyGUI: cannot write profiler trace to '%s'", filePath.c_str());
+        return false;
+    }
+
+    std::string json = exportTrace();
+    stream->Write(json.c_str(), json.size());
+    stream->Close();
+    return true;
+}
+
+void Profiler::clear()
+{
+    for (auto &it : _frames)
+        resetFrame(it);
+    resetCounts();
+    _depth = 0;
+}
+
+void Profiler::resetFrame(Frame & frame)
+{
+    frame.frameId = -1;
+    frame.start = 0;
+    frame.end = 0;
+    frame.zones.clear();
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        frame.counters[i] = 0;
+}
+
+void Profiler::resetCounts()
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        _counts[i] = 0;
+}
+
+long long Profiler::now()
+{
+#ifdef WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+double Profiler::toMicroseconds(long long ticks)
+{
+#ifdef WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    return ticks * 1000000.0 / frequency.QuadPart;
+#else
+    return ticks / 1000.0;
+#endif
+}
+
+NS_FGUI_END
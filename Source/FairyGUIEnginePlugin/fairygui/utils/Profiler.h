@@ -0,0 +1,118 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "FGUIMacros.h"
+
+#include <atomic>
+#include <thread>
+
+//Define FGUI_ENABLE_PROFILER to 0 to compile every zone and counter out.
+#ifndef FGUI_ENABLE_PROFILER
+#define FGUI_ENABLE_PROFILER 1
+#endif
+
+NS_FGUI_BEGIN
+
+//Zones are only recorded on the thread that enabled the profiler, which must be the one
+//calling beginFrame; anywhere else they cost a thread id check. Counters can be added from
+//any thread.
+class FGUI_IMPEXP Profiler
+{
+public:
+    enum Counter
+    {
+        DRAW_CALLS,
+        VERTICES,
+        EVENTS_DISPATCHED,
+        OBJECTS_CREATED,
+        TIMERS_FIRED,
+        LIST_BUDGET_OVERRUNS,
+        NODES_CULLED,
+        HIT_TESTS,
+        HIT_TESTS_SKIPPED,
+        ATLAS_DRAWS_SAVED,
+        COUNTER_COUNT
+    };
+
+    static Profiler* getInstance() { return &_inst; }
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(bool value);
+
+    int getFrameCapacity() const { return (int)_frames.size(); }
+    void setFrameCapacity(int value);
+
+    void beginFrame();
+    int beginZone(const char* name);
+    void endZone(int index);
+    void addCount(Counter counter, int value) { if (_enabled) _counts[counter].fetch_add(value, std::memory_order_relaxed); }
+
+    //values of the last finished frame
+    int getCount(Counter counter) const;
+    float getFrameTime() const;
+
+    std::string exportTrace() const;
+    bool saveTrace(const std::string& filePath) const;
+    void clear();
+
+private:
+    Profiler();
+
+    struct Zone
+    {
+        const char* name;
+        long long start;
+        long long end;
+        int depth;
+    };
+
+    struct Frame
+    {
+        int frameId;
+        long long start;
+        long long end;
+        std::vector<Zone> zones;
+        int counters[COUNTER_COUNT];
+    };
+
+    static long long now();
+    static double toMicroseconds(long long ticks);
+    void resetFrame(Frame& frame);
+    void resetCounts();
+
+    std::vector<Frame> _frames;
+    std::atomic<int> _counts[COUNTER_COUNT];
+    int _current;
+    int _depth;
+    int _frameId;
+    std::thread::id _ownerThread;
+    std::atomic<bool> _enabled;
+
+    static Profiler _inst;
+};
+
+class ProfileZone
+{
+public:
+    ProfileZone(const char* name) : _index(Profiler::getInstance()->beginZone(name)) {}
+    ~ProfileZone() { Profiler::getInstance()->endZone(_index); }
+
+private:
+    int _index;
+};
+
+NS_FGUI_END
+
+#if FGUI_ENABLE_PROFILER
+#define FGUI_PROFILE_CONCAT_(a, b) a##b
+#define FGUI_PROFILE_CONCAT(a, b) FGUI_PROFILE_CONCAT_(a, b)
+#define FGUI_PROFILE_ZONE(name) fairygui::ProfileZone FGUI_PROFILE_CONCAT(fguiProfileZone_, __LINE__)(name)
+#define FGUI_PROFILE_COUNT(counter, value) fairygui::Profiler::getInstance()->addCount(fairygui::Profiler::counter, value)
+#define FGUI_PROFILE_FRAME() fairygui::Profiler::getInstance()->beginFrame()
+#else
+#define FGUI_PROFILE_ZONE(name)
+#define FGUI_PROFILE_COUNT(counter, value)
+#define FGUI_PROFILE_FRAME()
+#endif
+
+#endif
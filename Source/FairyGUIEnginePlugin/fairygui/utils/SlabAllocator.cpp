@@ -0,0 +1,210 @@
+#include "SlabAllocator.h"
+
+NS_FGUI_BEGIN
+
+static const size_t SLAB_SIZE = 16 * 1024;
+
+std::mutex SlabAllocator::_mutex;
+SlabAllocator::SizeClass SlabAllocator::_classes[CLASS_COUNT];
+std::vector<void*> SlabAllocator::_slabs;
+std::map<char*, SlabArena*> SlabAllocator::_arenaSlabs;
+SlabArena* SlabAllocator::_currentArena = nullptr;
+int SlabAllocator::_allocationCount = 0;
+int SlabAllocator::_liveCount = 0;
+int SlabAllocator::_heapFallbackCount = 0;
+int SlabAllocator::_arenaCount = 0;
+
+void * SlabAllocator::allocate(size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _heapFallbackCount++;
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allocationCount++;
+    _liveCount++;
+
+    if (_currentArena != nullptr && _currentArena->_thread == std::this_thread::get_id())
+        return _currentArena->allocate(size);
+
+    int index = getClassIndex(size);
+    SizeClass& sc = _classes[index];
+    if (sc.freeList != nullptr)
+    {
+        FreeBlock* block = sc.freeList;
+        sc.freeList = block->next;
+        return block;
+    }
+
+    size_t blockSize = getBlockSize(index);
+    if (sc.cursor == nullptr || sc.cursor + blockSize > sc.end)
+        return refill(index);
+
+    void* ret = sc.cursor;
+    sc.cursor += blockSize;
+    return ret;
+}
+
+void SlabAllocator::deallocate(void * ptr, size_t size)
+{
+    if (ptr == nullptr)
+        return;
+
+    if (size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _liveCount--;
+
+    if (!_arenaSlabs.empty())
+    {
+        SlabArena* arena = findArena(ptr);
+        if (arena != nullptr)
+        {
+            if (arena->deallocate())
+                delete arena;
+            return;
+        }
+    }
+
+    SizeClass& sc = _classes[getClassIndex(size)];
+    FreeBlock* block = (FreeBlock*)ptr;
+    block->next = sc.freeList;
+    sc.freeList = block;
+}
+
+size_t SlabAllocator::getReservedBytes()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (_slabs.size() + _arenaSlabs.size()) * SLAB_SIZE;
+}
+
+int SlabAllocator::getClassIndex(size_t size)
+{
+    //16 byte steps up to 256, then 64 byte steps up to MAX_BLOCK_SIZE
+    if (size == 0)
+        return 0;
+    else if (size <= 256)
+        return (int)((size - 1) >> 4);
+    else
+        return 16 + (int)((size - 257) >> 6);
+}
+
+size_t SlabAllocator::getBlockSize(int index)
+{
+    if (index < 16)
+        return (index + 1) * 16;
+    else
+        return 256 + (index - 15) * 64;
+}
+
+void * SlabAllocator::refill(int index)
+{
+    //slabs are kept for the lifetime of the process; their blocks are recycled through the free lists
+    char* slab = (char*)::operator new(SLAB_SIZE);
+    _slabs.push_back(slab);
+
+    SizeClass& sc = _classes[index];
+    sc.cursor = slab + getBlockSize(index);
+    sc.end = slab + SLAB_SIZE;
+    return slab;
+}
+
+SlabArena * SlabAllocator::findArena(void * ptr)
+{
+    auto it = _arenaSlabs.upper_bound((char*)ptr);
+    if (it == _arenaSlabs.begin())
+        return nullptr;
+
+    --it;
+    if ((char*)ptr < it->first + SLAB_SIZE)
+        return it->second;
+    else
+        return nullptr;
+}
+
+SlabArena::SlabArena() :
+    _cursor(nullptr),
+    _end(nullptr),
+    _liveCount(0),
+    _released(false),
+    _previous(nullptr)
+{
+}
+
+SlabArena::~SlabArena()
+{
+    for (auto &slab : _slabs)
+    {
+        SlabAllocator::_arenaSlabs.erase(slab);
+        ::operator delete(slab);
+    }
+    SlabAllocator::_arenaCount--;
+}
+
+SlabArena * SlabArena::create()
+{
+    std::lock_guard<std::mutex> lock(SlabAllocator::_mutex);
+    SlabAllocator::_arenaCount++;
+    return new SlabArena();
+}
+
+void SlabArena::release()
+{
+    std::lock_guard<std::mutex> lock(SlabAllocator::_mutex);
+    CCASSERT(!_released && SlabAllocator::_currentArena != this, "FairyGUI: arena released while in use");
+    _released = true;
+    if (_liveCount == 0)
+        delete this;
+}
+
+void SlabArena::makeCurrent()
+{
+    std::lock_guard<std::mutex> lock(SlabAllocator::_mutex);
+    _thread = std::this_thread::get_id();
+    _previous = SlabAllocator::_currentArena;
+    SlabAllocator::_currentArena = this;
+}
+
+void SlabArena::restoreCurrent()
+{
+    std::lock_guard<std::mutex> lock(SlabAllocator::_mutex);
+    CCASSERT(SlabAllocator::_currentArena == this, "FairyGUI: arenas must be restored in reverse order");
+    SlabAllocator::_currentArena = _previous;
+    _previous = nullptr;
+}
+
+void * SlabArena::allocate(size_t size)
+{
+    //Blocks are only cut, never reused: the arena lives as long as its component and the
+    //memory is given back all at once. 16 byte steps keep the blocks aligned.
+    size = (size + 15) & ~(size_t)15;
+    if (_cursor == nullptr || _cursor + size > _end)
+    {
+        char* slab = (char*)::operator new(SLAB_SIZE);
+        _slabs.push_back(slab);
+        SlabAllocator::_arenaSlabs[slab] = this;
+        _cursor = slab;
+        _end = slab + SLAB_SIZE;
+    }
+
+    void* ret = _cursor;
+    _cursor += size;
+    _liveCount++;
+    return ret;
+}
+
+bool SlabArena::deallocate()
+{
+    //true when this was the last block of a released arena
+    _liveCount--;
+    return _released && _liveCount == 0;
+}
+
+NS_FGUI_END
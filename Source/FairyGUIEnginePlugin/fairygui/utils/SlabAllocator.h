@@ -0,0 +1,120 @@
+#ifndef __SLABALLOCATOR_H__
+#define __SLABALLOCATOR_H__
+
+#include "FGUIMacros.h"
+#include <map>
+#include <mutex>
+#include <thread>
+
+//Define FGUI_ENABLE_SLAB_POOLS to 0 to allocate the pooled types from the global heap again.
+#ifndef FGUI_ENABLE_SLAB_POOLS
+#define FGUI_ENABLE_SLAB_POOLS 1
+#endif
+
+NS_FGUI_BEGIN
+
+class SlabArena;
+
+//Size-class pools for the small objects every GObject is built from. Blocks are cut
+//from 16KB slabs and go back to a per-size free list when released, so creating and
+//disposing screens keeps reusing the same slabs instead of fragmenting the heap.
+//Blocks larger than MAX_BLOCK_SIZE fall back to the global heap. The pools are locked,
+//objects may be created and released on the worker threads too.
+class FGUI_IMPEXP SlabAllocator
+{
+public:
+    static const size_t MAX_BLOCK_SIZE = 1024;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size);
+
+    static int getAllocationCount() { return _allocationCount; }
+    static int getLiveCount() { return _liveCount; }
+    static int getHeapFallbackCount() { return _heapFallbackCount; }
+    static int getSlabCount() { return (int)_slabs.size(); }
+    static int getArenaCount() { return _arenaCount; }
+    static size_t getReservedBytes();
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct SizeClass
+    {
+        FreeBlock* freeList;
+        char* cursor;
+        char* end;
+    };
+
+    static const int CLASS_COUNT = 28;
+
+    static int getClassIndex(size_t size);
+    static size_t getBlockSize(int index);
+    static void* refill(int index);
+    static SlabArena* findArena(void* ptr);
+
+    static std::mutex _mutex;
+    static SizeClass _classes[CLASS_COUNT];
+    static std::vector<void*> _slabs;
+    //arena slabs by address, a freed block finds its arena here
+    static std::map<char*, SlabArena*> _arenaSlabs;
+    static SlabArena* _currentArena;
+    static int _allocationCount;
+    static int _liveCount;
+    static int _heapFallbackCount;
+    static int _arenaCount;
+
+    friend class SlabArena;
+};
+
+//A per-component arena. While it is current on the constructing thread, the pooled blocks
+//are cut from its own slabs, so a component and its children are built into a few slabs.
+//The slabs go back to the heap once the owner released it and every block is freed, a child
+//that is reparented and outlives its root keeps them alive instead of dangling.
+class FGUI_IMPEXP SlabArena
+{
+public:
+    static SlabArena* create();
+
+    //called by the owner when it is destroyed
+    void release();
+
+    void makeCurrent();
+    void restoreCurrent();
+
+    int getLiveCount() const { return _liveCount; }
+    int getSlabCount() const { return (int)_slabs.size(); }
+
+private:
+    SlabArena();
+    ~SlabArena();
+
+    void* allocate(size_t size);
+    bool deallocate();
+
+    std::vector<char*> _slabs;
+    char* _cursor;
+    char* _end;
+    int _liveCount;
+    bool _released;
+    std::thread::id _thread;
+    SlabArena* _previous;
+
+    friend class SlabAllocator;
+};
+
+NS_FGUI_END
+
+//Routes new/delete of a class, and of everything derived from it, through SlabAllocator.
+//The class must have a virtual destructor if it is deleted through a base pointer.
+#if FGUI_ENABLE_SLAB_POOLS
+#define FGUI_SLAB_ALLOCATED \
+    static void* operator new(size_t size) { return fairygui::SlabAllocator::allocate(size); } \
+    static void operator delete(void* ptr, size_t size) { fairygui::SlabAllocator::deallocate(ptr, size); }
+#else
+#define FGUI_SLAB_ALLOCATED
+#endif
+
+#endif
@@ -0,0 +1,119 @@
+#include "WorkerPool.h"
+#include "UIConfig.h"
+
+NS_FGUI_BEGIN
+
+static const int MAX_AUTO_THREADS = 4;
+
+WorkerPool::WorkerPool() :
+    _body(nullptr),
+    _count(0),
+    _next(0),
+    _busy(0),
+    _batch(0),
+    _started(false),
+    _stopping(false)
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto &it : _threads)
+        it.join();
+    _threads.clear();
+}
+
+int WorkerPool::getThreadCount()
+{
+    if (!_started)
+        startThreads();
+
+    return (int)_threads.size();
+}
+
+void WorkerPool::parallelFor(int count, const std::function<void(int)>& body)
+{
+    if (count <= 0)
+        return;
+
+    if (!_started)
+        startThreads();
+
+    if (_threads.empty() || count == 1)
+    {
+        for (int i = 0; i < count; i++)
+            body(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _body = &body;
+        _count = count;
+        _next = 0;
+        _busy = (int)_threads.size();
+        _batch++;
+    }
+    _condition.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this] { return _busy == 0; });
+    _body = nullptr;
+}
+
+void WorkerPool::startThreads()
+{
+    _started = true;
+
+    int cnt = UIConfig::workerThreadCount;
+    if (cnt < 0)
+    {
+        //leave one core to the calling thread, which also takes jobs
+        cnt = (int)std::thread::hardware_concurrency() - 1;
+        if (cnt > MAX_AUTO_THREADS)
+            cnt = MAX_AUTO_THREADS;
+    }
+
+    for (int i = 0; i < cnt; i++)
+        _threads.push_back(std::thread(&WorkerPool::threadMain, this));
+}
+
+void WorkerPool::threadMain()
+{
+    unsigned int batch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this, batch] { return _stopping || _batch != batch; });
+            if (_stopping)
+                return;
+
+            batch = _batch;
+        }
+
+        runJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy == 0)
+                _doneCondition.notify_one();
+        }
+    }
+}
+
+void WorkerPool::runJobs()
+{
+    int i;
+    while ((i = _next++) < _count)
+        (*_body)(i);
+}
+
+NS_FGUI_END
@@ -0,0 +1,49 @@
+#ifndef __WORKERPOOL_H__
+#define __WORKERPOOL_H__
+
+#include "FGUIMacros.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+NS_FGUI_BEGIN
+
+//Threads for splitting one batch of independent jobs, see parallelFor. Indices are
+//taken from a shared counter, so a thread that runs out of work keeps taking over
+//what the slower ones have not started. The threads are started on first use with
+//UIConfig::workerThreadCount.
+class FGUI_IMPEXP WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    int getThreadCount();
+
+    //Calls body(0..count-1) on the pool threads and on the calling thread,
+    //returns when all calls have finished. Batches must not be nested.
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+private:
+    void startThreads();
+    void threadMain();
+    void runJobs();
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _doneCondition;
+    const std::function<void(int)>* _body;
+    int _count;
+    std::atomic<int> _next;
+    int _busy;
+    unsigned int _batch;
+    bool _started;
+    bool _stopping;
+};
+
+NS_FGUI_END
+
+#endif